@@ -0,0 +1,37 @@
+#pragma once
+
+#include <cstdint>
+#include <atomic>
+#include <string>
+#include <vector>
+
+#include "Debug/Log.hpp"
+#include "Buffer.hpp"
+
+namespace Library::Debug
+{
+    // One ring per core: a handler only ever contends with code it
+    // interrupted on its own core or with the drainer, never spins on a lock.
+    class BinaryLog
+    {
+    public:
+        static void Push(const char* format, uint32_t count, uint32_t types, const uint64_t* args);
+        static std::vector<LogRecord> Drain(uint32_t max);
+        static std::string Format(const LogRecord& record);
+        static std::vector<LogFormat> Formats(const std::vector<LogRecord>& records);
+        static uint32_t Dropped();
+
+    private:
+        static constexpr const uint32_t CORE_COUNT = 3;
+        static constexpr const uint32_t RING_SIZE = 512;
+
+        static inline RingBuffer<LogRecord, RING_SIZE> rings[CORE_COUNT]{};
+
+        // head of each ring already popped by a drain that hit its max, so
+        // the next drain keeps the merge in timebase order
+        static inline SpinMutex drainMutex{};
+        static inline LogRecord heads[CORE_COUNT]{};
+        static inline bool held[CORE_COUNT]{};
+        static inline std::atomic<uint32_t> dropped{0};
+    };
+}
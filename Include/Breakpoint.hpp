@@ -4,6 +4,7 @@
 #include <atomic>
 #include <vector>
 
+#include <coreinit/context.h>
 #include <coreinit/thread.h>
 
 #include "Debug/Breakpoint.hpp"
@@ -34,10 +35,18 @@ namespace Library::Debug
 
         static std::vector<RegisterInfo> ConsumeDataBreakInfo();
         static std::vector<RegisterInfo> ConsumeInstructionBreakInfo();
+        static uint32_t DrainDataBreakInfo(RegisterInfo* out, uint32_t max);
+        static uint32_t DrainInstructionBreakInfo(RegisterInfo* out, uint32_t max);
+
+        static bool SetActions(BreakpointTarget target, const std::vector<BreakpointAction>& actions);
+        static void ClearActions(BreakpointTarget target);
+        static uint32_t Counter(uint32_t index);
+        static void ResetCounters();
 
     private:
         static void SetIABR(uint32_t value);
         static void SetDABR(uint32_t value);
+        static uint32_t CurrentDABR();
 
         static void SetSwitchThreadCallback(OSSwitchThreadCallbackFn function);
 
@@ -46,6 +55,11 @@ namespace Library::Debug
         static BOOL TraceHandler(OSContext* context);
         static void SwitchThreadHandler(OSThread* thread, OSThreadQueue*);
 
+        struct ActionList;
+        static ActionList& Actions(BreakpointTarget target);
+        static void PublishActions(ActionList& list, const BreakpointAction* actions, uint32_t count);
+        static void RunActions(ActionList& list, OSContext* context);
+
     private:
         static inline std::atomic<uint32_t> dabr{0};
         static inline std::atomic<uint32_t> dBreakpointAddress{0};
@@ -60,6 +74,30 @@ namespace Library::Debug
     private:
         static inline Map<uint32_t, uint32_t, 256> dMap{};
         static inline Map<uint32_t, uint32_t, 256> iMap{}; 
+        static inline bool watchArmed[3]{}; // per core, DABR holds a watch set slot
+
+        static constexpr const uint32_t MAX_ACTIONS = 8;
+        static constexpr const uint32_t MAX_COUNTERS = 16;
+
+        struct ActionSet
+        {
+            uint32_t count;
+            BreakpointAction actions[MAX_ACTIONS];
+        };
+
+        // Double buffered: a writer fills the set no handler is reading and
+        // then flips current, so a handler never sees a half written list.
+        struct ActionList
+        {
+            ActionSet sets[2];
+            std::atomic<uint32_t> current;
+            std::atomic<uint32_t> readers[2];
+        };
+
+        static inline ActionList iActions{};
+        static inline ActionList dActions{};
+        static inline SpinMutex actionMutex{};
+        static inline std::atomic<uint32_t> counters[MAX_COUNTERS]{};
 
         static constexpr const uint32_t MATCH_DABR_BIT = 1 << 22;
         static constexpr const uint32_t SINGLE_STEP_BIT = 1 << 10;
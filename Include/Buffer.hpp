@@ -3,6 +3,9 @@
 #include <cstdint>
 #include <atomic>
 
+#include <coreinit/memorymap.h>
+#include <coreinit/thread.h>
+
 namespace Library::Debug
 {
     class SpinMutex
@@ -13,6 +16,11 @@ namespace Library::Debug
             while (mFlag.test_and_set(std::memory_order_acquire)){}
         }
 
+        bool try_lock()
+        {
+            return !mFlag.test_and_set(std::memory_order_acquire);
+        }
+
         void unlock()
         {
             mFlag.clear(std::memory_order_release);
@@ -232,4 +240,87 @@ namespace Library::Debug
         alignas(64) std::atomic<uint32_t> mTail{0};
         Slot mSlots[Size]{};
     };
+
+    // Per-thread slots keyed by OSThread address, usable from any context.
+    // OSThread structures are often reused after a thread exits, so a slot is
+    // also tagged with the thread id and reset when either stops matching.
+    // When every slot is taken, one whose thread is gone is reclaimed.
+    // T must provide reset().
+    template<typename T, uint32_t Max>
+    class ThreadTable
+    {
+    public:
+        T* acquire(OSThread* thread)
+        {
+            uint32_t key = reinterpret_cast<uint32_t>(thread);
+            uint16_t id = thread->id;
+            uint32_t hash = (key >> 4) * 2654435761u;
+
+            for (uint32_t i = 0; i < Max; i++)
+            {
+                Slot& slot = mSlots[(hash + i) % Max];
+                uint32_t owner = slot.owner.load(std::memory_order_acquire);
+                if (owner == key)
+                {
+                    if (slot.id == id) return &slot.value;
+                    return claim(slot, owner, key, id);
+                }
+                if (owner == 0)
+                {
+                    if (T* value = claim(slot, owner, key, id)) return value;
+                }
+            }
+
+            for (uint32_t i = 0; i < Max; i++)
+            {
+                Slot& slot = mSlots[(hash + i) % Max];
+                uint32_t owner = slot.owner.load(std::memory_order_acquire);
+                if (owner == 0 || owner == kBusy || !stale(owner, slot.id)) continue;
+                if (T* value = claim(slot, owner, key, id)) return value;
+            }
+            return nullptr;
+        }
+
+        T& operator[](uint32_t index)
+        {
+            return mSlots[index].value;
+        }
+
+        static constexpr uint32_t size()
+        {
+            return Max;
+        }
+
+    private:
+        static constexpr uint32_t kBusy = 1;
+        static constexpr uint32_t kThreadTag = 0x74487244; // 'tHrD'
+        static constexpr uint8_t kStateNone = 0;
+        static constexpr uint8_t kStateMoribund = 8;
+
+        struct Slot
+        {
+            std::atomic<uint32_t> owner{0};
+            uint16_t id = 0;
+            T value{};
+        };
+
+        static bool stale(uint32_t owner, uint16_t id)
+        {
+            if (!OSIsAddressValid(owner) || !OSIsAddressValid(owner + sizeof(OSThread) - 1)) return true;
+            const OSThread* thread = reinterpret_cast<const OSThread*>(owner);
+            if (thread->tag != kThreadTag || thread->id != id) return true;
+            return thread->state == kStateNone || thread->state == kStateMoribund;
+        }
+
+        T* claim(Slot& slot, uint32_t expected, uint32_t key, uint16_t id)
+        {
+            if (!slot.owner.compare_exchange_strong(expected, kBusy, std::memory_order_acq_rel)) return nullptr;
+            slot.id = id;
+            slot.value.reset();
+            slot.owner.store(key, std::memory_order_release);
+            return &slot.value;
+        }
+
+        Slot mSlots[Max]{};
+    };
 }
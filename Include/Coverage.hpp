@@ -0,0 +1,50 @@
+#pragma once
+
+#include <cstdint>
+#include <atomic>
+#include <memory>
+#include <vector>
+
+#include <coreinit/context.h>
+
+#include "Debug/Coverage.hpp"
+
+namespace Library::Debug
+{
+    class Coverage
+    {
+    public:
+        static void Initialize();
+
+        static uint32_t Start(const std::vector<uint32_t>& addresses);
+        static void Stop();
+
+        static std::vector<uint32_t> Addresses();
+        static std::vector<uint32_t> Bitmap();
+        static uint32_t HitCount();
+
+    private:
+        // Immutable once published; the handler may still be reading it on
+        // another core while the next session starts.
+        struct Table
+        {
+            std::vector<uint32_t> addresses;
+            std::vector<uint32_t> originals;
+            std::unique_ptr<std::atomic<uint32_t>[]> bitmap;
+        };
+
+        static BOOL ProgramHandler(OSContext* context);
+        static bool Resolve(Table* table, OSContext* context);
+
+    private:
+        static inline std::atomic<Table*> table{nullptr};
+        static inline std::atomic<Table*> previous{nullptr}; // its traps may still be in flight
+        static inline std::unique_ptr<Table> owned{};
+        static inline std::unique_ptr<Table> retired{};
+        static inline std::atomic<bool> active{false};
+        static inline std::atomic<uint32_t> readers{0}; // handlers holding a table
+
+        static constexpr const uint32_t TRAP_INSTRUCTION = 0x7FE00008; // tw 31, r0, r0
+        static constexpr const uint32_t TRAP_BIT = 1 << 17;            // SRR1[14]
+    };
+}
@@ -0,0 +1,81 @@
+#pragma once
+
+#include <cstdint>
+#include <atomic>
+
+#include <coreinit/context.h>
+#include <coreinit/exception.h>
+
+#include "Debug/CrashDump.hpp"
+
+namespace Library::Debug
+{
+    // Write runs on the exception stack: everything is staged into a static
+    // buffer without allocating or taking locks. Resume then sends the crashed
+    // thread out of exception context into Persist, which hands the buffer to
+    // the sink and ends in OSFatal.
+    class CrashDump
+    {
+    public:
+        static void Enable(CrashDumpSink sink, void* context);
+        static void Disable();
+
+        static bool AddRange(uint32_t address, uint32_t size);
+        static void ClearRanges();
+
+        static bool Write(OSExceptionType type, OSContext* context, uint32_t core);
+        static void Resume(OSContext* context, const char* message);
+
+        static constexpr const uint16_t VERSION = 1;
+        static constexpr const uint16_t FLAG_TRUNCATED = 1 << 0;
+
+        static constexpr const uint32_t TAG_CONTEXT = 1;
+        static constexpr const uint32_t TAG_STACK = 2;
+        static constexpr const uint32_t TAG_THREADS = 3;
+        static constexpr const uint32_t TAG_MEMORY = 4;
+
+        static constexpr const uint32_t HEADER_SIZE = 32;
+        static constexpr const uint32_t THREAD_NAME_SIZE = 32;
+
+    private:
+        struct Range
+        {
+            uint32_t address;
+            uint32_t size;
+        };
+
+        static bool IsReadable(uint32_t address, uint32_t size);
+
+        static bool Put32(uint32_t value);
+        static bool Put64(uint64_t value);
+        static bool PutBytes(const void* data, uint32_t size);
+        static uint32_t BeginSection(uint32_t tag);
+        static void EndSection(uint32_t offset);
+
+        static void WriteContext(OSContext* context);
+        static void WriteStack(OSContext* context);
+        static void WriteThreads();
+        static void WriteMemory();
+
+        static void Persist(const char* message);
+
+    private:
+        static constexpr const uint32_t BUFFER_SIZE = CRASH_DUMP_MAX_SIZE;
+        static constexpr const uint32_t MAX_RANGES = 8;
+        static constexpr const uint32_t MAX_FRAMES = 64;
+        static constexpr const uint32_t MAX_THREADS = 128;
+        static constexpr const uint32_t PERSIST_STACK_SIZE = 0x4000;
+
+        alignas(32) static inline uint8_t buffer[BUFFER_SIZE]{};
+        static inline uint32_t size = 0;
+        static inline bool truncated = false;
+
+        static inline Range ranges[MAX_RANGES]{};
+        static inline std::atomic<uint32_t> rangeCount{0};
+
+        static inline std::atomic<CrashDumpSink> sink{nullptr};
+        static inline void* sinkContext = nullptr;
+        static inline std::atomic_flag writing = ATOMIC_FLAG_INIT;
+        alignas(16) static inline uint8_t persistStack[PERSIST_STACK_SIZE]{};
+    };
+}
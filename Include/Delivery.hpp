@@ -0,0 +1,52 @@
+#pragma once
+
+#include <cstdint>
+#include <atomic>
+
+#include <coreinit/thread.h>
+
+#include "Debug/Breakpoint.hpp"
+#include "Debug/Delivery.hpp"
+#include "Buffer.hpp"
+
+namespace Library::Debug
+{
+    // Drains the hit buffers on its own thread so consumers are called back
+    // instead of polling; the exception side keeps pushing lock-free.
+    class Delivery
+    {
+    public:
+        static bool Start(const DeliveryConfig& config);
+        static void Stop();
+
+        static void SetDataCallback(BreakInfoCallback callback, void* context);
+        static void SetInstructionCallback(BreakInfoCallback callback, void* context);
+
+    private:
+        struct Callback
+        {
+            BreakInfoCallback function;
+            void* context;
+        };
+
+        static void Quiesce();
+        static int Worker(int argc, const char** argv);
+        static uint32_t Deliver(const Callback& callback, uint32_t (*drain)(RegisterInfo*, uint32_t));
+
+    private:
+        static constexpr const uint32_t MAX_BATCH = 64;
+        static constexpr const uint32_t STACK_SIZE = 0x4000;
+
+        static inline DeliveryConfig config{};
+        static inline Callback dataCallback{};
+        static inline Callback instructionCallback{};
+        static inline SpinMutex mutex{};
+        static inline std::atomic<bool> running{false};
+        static inline std::atomic<bool> delivering{false};
+        static inline std::atomic<uint32_t> passes{0};
+
+        static inline RegisterInfo batch[MAX_BATCH]{};
+        alignas(16) static inline uint8_t stack[STACK_SIZE]{};
+        static inline OSThread thread{};
+    };
+}
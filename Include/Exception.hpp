@@ -1,9 +1,20 @@
 #pragma once
 
+#include <cstdint>
+
+#include <coreinit/context.h>
 #include <coreinit/kernel.h>
 
+#include "Debug/Exception.hpp"
+
+extern "C"
+{
+    void ExceptionSwitchStack(uint32_t type, OSContext* interrupted, uint32_t core, void* stack, void (*function)(uint32_t, OSContext*, uint32_t));
+}
+
 namespace Library::Debug::Exception
 {
     void Initialize(); // Initialization required for each core
     void SetCallback(OSExceptionType type, OSExceptionCallbackFn function);
+    ExceptionNesting GetNesting(uint32_t core);
 }
\ No newline at end of file
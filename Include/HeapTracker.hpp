@@ -0,0 +1,109 @@
+#pragma once
+
+#include <cstdint>
+#include <atomic>
+#include <unordered_map>
+#include <vector>
+
+#include <coreinit/memdefaultheap.h>
+#include <coreinit/mutex.h>
+#include <coreinit/thread.h>
+#include <coreinit/time.h>
+
+#include "Debug/Heap.hpp"
+#include "Buffer.hpp"
+
+namespace Library::Debug
+{
+    // Swaps the default heap function pointers. The hooks only push into a
+    // per-thread ring; a low priority thread drains them into the aggregates.
+    class HeapTracker
+    {
+    public:
+        static void Initialize();
+
+        static bool Start();
+        static void Stop();
+
+        static HeapReport Collect(uint32_t minLeakAge);
+        static void Reset();
+
+    private:
+        struct Event
+        {
+            uint32_t address;
+            uint32_t size; // FREE_FLAG set on free
+            uint32_t frames[HEAP_STACK_DEPTH];
+            OSTime time;
+        };
+
+        struct ThreadHeap
+        {
+            RingBuffer<Event, 256> events;
+
+            void reset() {} // events left by a previous thread still count
+        };
+
+        struct Site
+        {
+            uint32_t frames[HEAP_STACK_DEPTH];
+            uint32_t allocations;
+            uint32_t frees;
+            uint64_t allocatedBytes;
+            uint32_t liveCount;
+            uint64_t liveBytes;
+        };
+
+        struct Live
+        {
+            uint32_t size;
+            uint32_t stack;
+            OSTime time;
+        };
+
+        struct Orphan
+        {
+            uint32_t address;
+            OSTime time;
+        };
+
+        static void* Alloc(uint32_t size);
+        static void* AllocEx(uint32_t size, int32_t alignment);
+        static void Free(void* block);
+
+        static void Record(uint32_t address, uint32_t size, uint32_t sp);
+
+        static int Drainer(int argc, const char** argv);
+        static void Drain();
+        static void Consume(const Event& event);
+
+    private:
+        static constexpr const uint32_t MAX_THREADS = 64;
+        static constexpr const uint32_t MAX_ORPHANS = 128;
+        static constexpr const uint32_t FREE_FLAG = 1u << 31;
+        static constexpr const uint32_t DRAIN_STACK_SIZE = 0x4000;
+        static constexpr const int32_t DRAIN_PRIORITY = 30;
+
+        static inline MEMAllocFromDefaultHeapFn originalAlloc = nullptr;
+        static inline MEMAllocFromDefaultHeapExFn originalAllocEx = nullptr;
+        static inline MEMFreeToDefaultHeapFn originalFree = nullptr;
+
+        static inline ThreadTable<ThreadHeap, MAX_THREADS> threads{};
+        static inline std::atomic<uint32_t> dropped{0};
+        static inline std::atomic<bool> running{false};
+
+        alignas(16) static inline uint8_t drainStack[DRAIN_STACK_SIZE]{};
+        static inline OSThread drainThread{};
+
+        // consumer side, guarded by mutex; a sleeping lock since the drainer
+        // allocates while holding it at low priority
+        static inline OSMutex mutex{};
+        static inline std::vector<Event> batch{};
+        static inline std::unordered_map<uint32_t, Site> sites{};
+        static inline std::unordered_map<uint32_t, Live> live{};
+        static inline Orphan orphans[MAX_ORPHANS]{};
+        static inline uint32_t orphanCount = 0;
+        static inline OSTime lastDrain = 0;
+        static inline OSTime startTime = 0;
+    };
+}
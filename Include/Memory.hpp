@@ -0,0 +1,34 @@
+#pragma once
+
+#include <cstdint>
+
+#include <coreinit/context.h>
+
+namespace Library::Debug
+{
+    extern "C"
+    {
+        uint32_t MemoryCopy(void* dst, const void* src, uint32_t size);
+        uint32_t MemoryStore(uint32_t address, uint32_t value, uint32_t size);
+        void MemoryCopyFault();
+        void MemoryCopyEnd();
+    }
+
+    class Memory
+    {
+    public:
+        static uint32_t Read(uint32_t address, void* buffer, uint32_t size);
+        static uint32_t Write(uint32_t address, const void* buffer, uint32_t size);
+        static bool Store(uint32_t address, uint32_t value, uint32_t size);
+
+        static BOOL DSIHandler(OSContext* context);
+        static bool IsCodeAddress(uint32_t address);
+
+    private:
+        static uint32_t WriteCode(uint32_t address, const void* buffer, uint32_t size);
+
+        static constexpr const uint32_t CODE_BEGIN = 0x01000000;
+        static constexpr const uint32_t CODE_END = 0x10000000;
+        static constexpr const uint32_t PAGE_SIZE = 0x1000;
+    };
+}
@@ -0,0 +1,63 @@
+#pragma once
+
+#include <cstdint>
+#include <atomic>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include <coreinit/dynload.h>
+
+#include "Debug/Module.hpp"
+#include "Buffer.hpp"
+
+namespace Library::Debug
+{
+    class ModuleMap
+    {
+    public:
+        static void Initialize();
+        static void Shutdown();
+
+        static std::vector<ModuleInfo> Modules();
+        static std::vector<ModuleLocation> Resolve(const std::vector<uint32_t>& addresses);
+
+        static uint32_t LoadSymbols(std::string_view map);
+        static std::string SymbolName(int32_t symbol);
+
+    private:
+        struct Range
+        {
+            uint32_t begin;
+            uint32_t end;
+            int32_t module;
+            ModuleSection section;
+        };
+
+        struct Symbol
+        {
+            uint32_t address;
+            uint32_t size; // 0 when the map gave none and no symbol follows
+            std::string name;
+        };
+
+        // Immutable once published; readers keep their own reference so
+        // nothing is copied or freed while the mutex is held.
+        struct Snapshot
+        {
+            std::vector<ModuleInfo> modules;
+            std::vector<Range> ranges;
+        };
+
+        static std::shared_ptr<const Snapshot> Refresh();
+        static void Notify(OSDynLoad_Module module, void* context, OSDynLoad_NotifyReason reason, OSDynLoad_NotifyData* data);
+        static void ResolveOne(const Snapshot& snapshot, const std::vector<Symbol>& table, uint32_t address, ModuleLocation& location, uint32_t& hint);
+
+    private:
+        static inline std::shared_ptr<const Snapshot> snapshot = std::make_shared<const Snapshot>();
+        static inline std::shared_ptr<const std::vector<Symbol>> symbols = std::make_shared<const std::vector<Symbol>>();
+        static inline std::atomic<bool> dirty{true};
+        static inline SpinMutex mutex{};
+    };
+}
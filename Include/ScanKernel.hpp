@@ -0,0 +1,70 @@
+#pragma once
+
+#include <cstdint>
+#include <cstring>
+
+#include "Debug/Scanner.hpp"
+
+// Comparisons and word kernels of the scanner. Only depends on the standard
+// library so they can be tested on the host.
+namespace Library::Debug
+{
+    template<typename T>
+    inline bool CompareValue(ScanCompare compare, const uint8_t* current, const uint8_t* previous, const uint8_t* value)
+    {
+        T c{}, p{}, v{};
+        std::memcpy(&c, current, sizeof(T));
+        if (previous) std::memcpy(&p, previous, sizeof(T));
+        std::memcpy(&v, value, sizeof(T));
+
+        switch (compare)
+        {
+            case ScanCompare::Unknown: return true;
+            case ScanCompare::Equal: return c == v;
+            case ScanCompare::NotEqual: return c != v;
+            case ScanCompare::Greater: return c > v;
+            case ScanCompare::Less: return c < v;
+            case ScanCompare::Changed: return c != p;
+            case ScanCompare::Unchanged: return c == p;
+            case ScanCompare::Increased: return c > p;
+            case ScanCompare::Decreased: return c < p;
+            default: return false;
+        }
+    }
+
+    inline bool CompareBytes(ScanCompare compare, const uint8_t* current, const uint8_t* previous, const uint8_t* value, const uint8_t* mask, uint32_t size)
+    {
+        const uint8_t* other = nullptr;
+        bool equal = true;
+        switch (compare)
+        {
+            case ScanCompare::Unknown: return true;
+            case ScanCompare::Equal: case ScanCompare::NotEqual: other = value; equal = compare == ScanCompare::Equal; break;
+            case ScanCompare::Changed: case ScanCompare::Unchanged: other = previous; equal = compare == ScanCompare::Unchanged; break;
+            default: return false;
+        }
+
+        for (uint32_t i = 0; i < size; i++)
+        {
+            if ((current[i] ^ other[i]) & mask[i]) return !equal;
+        }
+        return equal;
+    }
+
+    // Bit n is set when byte n of word equals the same byte of pattern,
+    // counting from the most significant byte: memory order on the Espresso.
+    inline uint32_t MatchBytes(uint32_t word, uint32_t pattern)
+    {
+        uint32_t x = word ^ pattern;
+        uint32_t z = ~(((x & 0x7F7F7F7Fu) + 0x7F7F7F7Fu) | x | 0x7F7F7F7Fu);
+        return ((z >> 31) & 1) | ((z >> 22) & 2) | ((z >> 13) & 4) | ((z >> 4) & 8);
+    }
+
+    // Same for the two halfwords of word
+    inline uint32_t MatchHalves(uint32_t word, uint32_t pattern)
+    {
+        uint32_t x = word ^ pattern;
+        uint32_t z = ~(((x & 0x7FFF7FFFu) + 0x7FFF7FFFu) | x | 0x7FFF7FFFu);
+        return ((z >> 31) & 1) | ((z >> 14) & 2);
+    }
+}
@@ -0,0 +1,73 @@
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+#include "Debug/Scanner.hpp"
+#include "WorkerPool.hpp"
+
+namespace Library::Debug
+{
+    class Scanner
+    {
+    public:
+        static uint32_t First(const std::vector<ScanRange>& ranges, ScanType type, ScanCompare compare, const std::vector<uint8_t>& value, const std::vector<uint8_t>& mask, uint32_t alignment);
+        static uint32_t Next(ScanCompare compare, const std::vector<uint8_t>& value);
+
+        static uint32_t Count();
+        static std::vector<uint32_t> Results(uint32_t offset, uint32_t max);
+        static void Reset();
+
+    private:
+        // Candidates are kept as one bit per aligned slot; previous values are
+        // packed in candidate order so a rescan only touches set bits.
+        struct Region
+        {
+            uint32_t begin;
+            uint32_t slots;
+            uint32_t count;
+            std::vector<uint32_t> bitmap;
+            std::vector<uint8_t> values;
+        };
+
+        struct Job
+        {
+            Region* region;
+            uint32_t wordBegin;
+            uint32_t wordEnd;
+            uint32_t valueBegin;
+            uint32_t count;
+            std::vector<uint32_t> bitmap;
+            std::vector<uint8_t> values;
+        };
+
+        static void BuildJobs();
+        static void Dispatch();
+        static void Merge();
+
+        static int Worker(int argc, const char** argv);
+        static uint32_t ScanWord(Job& job, uint32_t word, uint32_t& valueIndex, uint32_t& validPage);
+        static uint32_t ScanWordFast(uint32_t address);
+        static bool CanScanFast(const Region& region, uint32_t word);
+        static bool Match(const uint8_t* current, const uint8_t* previous);
+        static bool IsOrdered(ScanCompare compare);
+        static bool IsReadable(uint32_t begin, uint32_t end, uint32_t& validPage);
+
+    private:
+        static constexpr const uint32_t MAX_PATTERN_SIZE = 64;
+        static constexpr const uint32_t WORKER_COUNT = WorkerPool::WORKER_COUNT;
+        static constexpr const uint32_t PAGE_SIZE = 0x1000;
+
+        static inline std::vector<Region> regions{};
+        static inline std::vector<Job> jobs{};
+        static inline WorkerPool workers{};
+
+        static inline ScanType type = ScanType::U32;
+        static inline ScanCompare compare = ScanCompare::Unknown;
+        static inline uint32_t width = 0;
+        static inline uint32_t stride = 0;
+        static inline uint8_t value[MAX_PATTERN_SIZE]{};
+        static inline uint8_t mask[MAX_PATTERN_SIZE]{};
+        static inline bool first = false;
+    };
+}
@@ -0,0 +1,55 @@
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+#include "Debug/Scanner.hpp"
+#include "Debug/Snapshot.hpp"
+#include "WorkerPool.hpp"
+
+namespace Library::Debug
+{
+    // Keeps one 64 bit hash per block instead of the memory itself; a diff
+    // rehashes every block and only touches the data of blocks that changed.
+    class Snapshot
+    {
+    public:
+        static uint32_t Take(const std::vector<ScanRange>& ranges, uint32_t size);
+        static std::vector<SnapshotChange> Diff(bool capture, bool commit);
+        static void Reset();
+
+    private:
+        struct Region
+        {
+            uint32_t begin;
+            uint32_t blocks;
+            std::vector<uint64_t> hashes;
+            std::vector<uint32_t> changed; // one bit per block, written by the last pass
+        };
+
+        struct Job
+        {
+            Region* region;
+            uint32_t blockBegin; // multiple of 32 so jobs never share a changed word
+            uint32_t blockEnd;
+        };
+
+        static void BuildJobs();
+        static void Dispatch();
+
+        static int Worker(int argc, const char** argv);
+        static uint64_t HashBlock(uint32_t address);
+
+    private:
+        static constexpr const uint32_t WORKER_COUNT = WorkerPool::WORKER_COUNT;
+        static constexpr const uint32_t JOB_BLOCKS = 256;
+        static constexpr const uint32_t PAGE_SIZE = 0x1000;
+        static constexpr const uint64_t INVALID_HASH = 0;
+
+        static inline std::vector<Region> regions{};
+        static inline std::vector<Job> jobs{};
+        static inline WorkerPool workers{};
+        static inline uint32_t blockSize = PAGE_SIZE;
+        static inline bool update = true;
+    };
+}
@@ -0,0 +1,59 @@
+#pragma once
+
+#include <bit>
+#include <cstdint>
+#include <vector>
+
+// Block hash and change-run extraction of the snapshot. Only depends on the
+// standard library so they can be tested on the host.
+namespace Library::Debug
+{
+    // Four independent 32 bit lanes keep the multiplier busy while the next
+    // cache line is being fetched. Each step is a bijection of the lane state,
+    // so blocks differing in a single word always hash differently. count is
+    // a multiple of 8; never returns 0, which marks an unreadable block.
+    inline uint64_t HashWords(const uint32_t* p, uint32_t count)
+    {
+        const uint32_t* end = p + count;
+
+        uint32_t a = 0x243F6A88, b = 0x85A308D3, c = 0x13198A2E, d = 0x03707344;
+        for (; p < end; p += 8)
+        {
+            __builtin_prefetch(p + 16);
+            a = std::rotl((a ^ p[0]) * 0x9E3779B1u, 13);
+            b = std::rotl((b ^ p[1]) * 0x85EBCA77u, 13);
+            c = std::rotl((c ^ p[2]) * 0x9E3779B1u, 13);
+            d = std::rotl((d ^ p[3]) * 0x85EBCA77u, 13);
+            a = std::rotl((a ^ p[4]) * 0x9E3779B1u, 13);
+            b = std::rotl((b ^ p[5]) * 0x85EBCA77u, 13);
+            c = std::rotl((c ^ p[6]) * 0x9E3779B1u, 13);
+            d = std::rotl((d ^ p[7]) * 0x85EBCA77u, 13);
+        }
+
+        uint64_t hash = (static_cast<uint64_t>(a ^ std::rotl(c, 7)) << 32) | (b ^ std::rotl(d, 11));
+        return hash == 0 ? 1 : hash;
+    }
+
+    // Calls run(first, count) for every run of set bits among the first
+    // blocks bits of changed, skipping clear words whole.
+    template<typename Run>
+    inline void ForEachRun(const std::vector<uint32_t>& changed, uint32_t blocks, Run run)
+    {
+        uint32_t block = 0;
+        while (block < blocks)
+        {
+            uint32_t word = changed[block / 32] >> (block % 32);
+            if (word == 0)
+            {
+                block = (block / 32 + 1) * 32;
+                continue;
+            }
+            block += std::countr_zero(word);
+            if (block >= blocks) break;
+
+            uint32_t first = block;
+            while (block < blocks && (changed[block / 32] >> (block % 32)) & 1) block++;
+            run(first, block - first);
+        }
+    }
+}
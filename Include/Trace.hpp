@@ -0,0 +1,121 @@
+#pragma once
+
+#include <cstdint>
+#include <atomic>
+#include <map>
+#include <utility>
+#include <vector>
+
+#include <coreinit/thread.h>
+#include <coreinit/time.h>
+
+#include "Debug/Trace.hpp"
+#include "Buffer.hpp"
+
+namespace Library::Debug
+{
+    extern "C"
+    {
+        void TraceEntryCommon();
+        void TraceExitStub();
+        extern uint8_t TracePool[];
+
+        uint32_t TraceEnter(uint32_t index, uint32_t lr, uint32_t sp);
+        uint32_t TraceExit(uint32_t sp);
+    }
+
+    class Trace
+    {
+    public:
+        static bool Hook(uint32_t address);
+        static bool Unhook(uint32_t address);
+
+        static TraceGraph Collect();
+        static void Reset();
+
+        static uint32_t Enter(uint32_t index, uint32_t lr, uint32_t sp);
+        static uint32_t Exit(uint32_t sp);
+
+    private:
+        struct Event
+        {
+            uint32_t index; // EXIT_FLAG set on exit
+            uint32_t depth;
+            uint32_t generation; // of the slot, a new thread starts a new stack
+            OSTime time;
+        };
+
+        struct Frame
+        {
+            uint32_t index;
+            uint32_t lr;
+            uint32_t sp; // caller stack pointer, identical on entry and return
+        };
+
+        struct ThreadTrace
+        {
+            uint32_t depth;
+            uint32_t generation;
+            Frame frames[64];
+            RingBuffer<Event, 256> events;
+
+            // Events of the previous thread are discarded here; any the
+            // consumer already popped are told apart by generation.
+            void reset()
+            {
+                depth = 0;
+                generation++;
+                events.clear();
+            }
+        };
+
+        struct Hooked
+        {
+            uint32_t address;
+            uint32_t original;
+        };
+
+        struct Pending
+        {
+            uint32_t index;
+            OSTime time;
+            OSTime child;
+        };
+
+        struct Node
+        {
+            uint32_t calls;
+            OSTime inclusive;
+            OSTime exclusive;
+        };
+
+        struct Edge
+        {
+            uint32_t calls;
+            OSTime inclusive;
+        };
+
+        static bool Relocate(uint32_t instruction, uint32_t from, uint32_t to, uint32_t& out);
+        static bool MakeBranch(uint32_t from, uint32_t to, uint32_t& out);
+        static void Consume(uint32_t thread, const Event& event);
+
+    private:
+        static constexpr const uint32_t MAX_HOOKS = 256;
+        static constexpr const uint32_t MAX_THREADS = 64;
+        static constexpr const uint32_t MAX_DEPTH = 64;
+        static constexpr const uint32_t SLOT_SIZE = 16;
+        static constexpr const uint32_t EXIT_FLAG = 1u << 31;
+
+        static inline Hooked hooks[MAX_HOOKS]{};
+        static inline std::atomic<uint32_t> hookCount{0};
+        static inline ThreadTable<ThreadTrace, MAX_THREADS> threads{};
+        static inline std::atomic<uint32_t> dropped{0};
+        static inline SpinMutex mutex{};
+
+        // consumer side, only touched by Collect/Reset
+        static inline std::vector<Pending> pending[MAX_THREADS]{};
+        static inline uint32_t pendingGeneration[MAX_THREADS]{};
+        static inline std::map<uint32_t, Node> nodes{};
+        static inline std::map<std::pair<uint32_t, uint32_t>, Edge> edges{};
+    };
+}
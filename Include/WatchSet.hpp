@@ -0,0 +1,74 @@
+#pragma once
+
+#include <cstdint>
+#include <atomic>
+#include <vector>
+
+#include <coreinit/context.h>
+#include <coreinit/time.h>
+
+#include "Debug/Breakpoint.hpp"
+#include "Debug/WatchSet.hpp"
+#include "Buffer.hpp"
+
+namespace Library::Debug
+{
+    // Rotates the single DABR through the registered addresses. While the set
+    // is not empty it takes precedence over the data breakpoint. DABR is per
+    // core, so each core tracks the slot it armed and is charged exposure for
+    // it; slots never move, a generation tells a reused slot apart.
+    class WatchSet
+    {
+    public:
+        static bool Add(uint32_t address, bool read, bool write, BreakpointSize size);
+        static bool Remove(uint32_t address);
+        static void Clear();
+
+        static void SetSliceTime(uint32_t microseconds);
+        static std::vector<WatchStat> Stats();
+
+        static bool IsActive();
+        static uint32_t Arm(uint32_t core);   // called on thread switch, returns the DABR to arm
+        static uint32_t Armed(uint32_t core); // DABR this core armed last, 0 if its slot is gone
+        static void Record(OSContext* context);
+
+    private:
+        static void Rotate(OSTime now);
+        static void Charge(uint32_t core, OSTime now);
+
+        struct Slot
+        {
+            std::atomic<uint32_t> generation; // 0 while free
+            std::atomic<uint32_t> dabr;
+            std::atomic<uint32_t> address;
+            std::atomic<uint32_t> size;
+            std::atomic<uint32_t> hits;
+            std::atomic<uint32_t> lastPc;
+            std::atomic<uint32_t> lastLr;
+            OSTime exposure[3]; // per core, guarded by exposureSequence
+        };
+
+        struct Core
+        {
+            uint32_t index;
+            uint32_t generation;
+            OSTime since;
+        };
+
+        static constexpr const uint32_t MAX_SLOTS = 64;
+        static constexpr const uint32_t CORE_COUNT = 3;
+
+        static inline Slot slots[MAX_SLOTS]{};
+        static inline std::atomic<uint32_t> count;
+        static inline std::atomic<uint32_t> current;
+        static inline uint32_t nextGeneration = 1;
+        static inline OSTime sliceStart = 0;
+        static inline OSTime sliceTicks = OSMicrosecondsToTicks(1000);
+        static inline SpinMutex mutex{};
+        static inline std::atomic<uint32_t> recording{0};
+
+        // each entry is only written from its own core's switch callback
+        static inline Core cores[CORE_COUNT]{};
+        static inline std::atomic<uint32_t> exposureSequence[CORE_COUNT]{};
+    };
+}
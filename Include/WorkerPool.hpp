@@ -0,0 +1,26 @@
+#pragma once
+
+#include <cstdint>
+
+#include <coreinit/thread.h>
+
+namespace Library::Debug
+{
+    // One worker thread per core, each on its own static stack. Every user
+    // owns a pool so concurrent scans and snapshots never share a stack.
+    class WorkerPool
+    {
+    public:
+        // Runs worker(i, nullptr) for every core i and waits for all of them
+        void Run(OSThreadEntryPointFn worker);
+
+        static constexpr const uint32_t WORKER_COUNT = 3;
+
+    private:
+        static constexpr const uint32_t STACK_SIZE = 0x4000;
+        static constexpr const int32_t PRIORITY = 20;
+
+        alignas(16) uint8_t _stacks[WORKER_COUNT][STACK_SIZE]{};
+        OSThread _threads[WORKER_COUNT]{};
+    };
+}
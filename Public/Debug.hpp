@@ -1,12 +1,25 @@
 #pragma once
 
 #include <cstdint>
+#include <string>
+#include <string_view>
 #include <vector>
 
 #include <coreinit/exception.h>
 #include <coreinit/thread.h>
 
 #include "Debug/Breakpoint.hpp"
+#include "Debug/Coverage.hpp"
+#include "Debug/CrashDump.hpp"
+#include "Debug/Delivery.hpp"
+#include "Debug/Exception.hpp"
+#include "Debug/Heap.hpp"
+#include "Debug/Log.hpp"
+#include "Debug/Module.hpp"
+#include "Debug/Scanner.hpp"
+#include "Debug/Snapshot.hpp"
+#include "Debug/Trace.hpp"
+#include "Debug/WatchSet.hpp"
 
 namespace Library::Debug
 {
@@ -20,4 +33,66 @@ namespace Library::Debug
     void SetInstructionBreakpoint(uint32_t address);
     void UnsetInstructionBreakpoint();
     std::vector<RegisterInfo> ConsumeInstructionBreakInfo();
+
+    bool StartDelivery(const DeliveryConfig& config = {});
+    void StopDelivery();
+    void SetDataBreakCallback(BreakInfoCallback callback, void* context = nullptr);
+    void SetInstructionBreakCallback(BreakInfoCallback callback, void* context = nullptr);
+
+    bool SetBreakpointActions(BreakpointTarget target, const std::vector<BreakpointAction>& actions);
+    void ClearBreakpointActions(BreakpointTarget target);
+    uint32_t GetBreakpointCounter(uint32_t index);
+    void ResetBreakpointCounters();
+
+    bool AddWatch(uint32_t address, bool read, bool write, BreakpointSize size);
+    bool RemoveWatch(uint32_t address);
+    void ClearWatches();
+    void SetWatchSliceTime(uint32_t microseconds);
+    std::vector<WatchStat> GetWatchStats();
+
+    uint32_t StartCoverage(const std::vector<uint32_t>& addresses);
+    void StopCoverage();
+    std::vector<uint32_t> GetCoverageAddresses();
+    std::vector<uint32_t> GetCoverageBitmap();
+    uint32_t GetCoverageHitCount();
+
+    bool HookFunction(uint32_t address);
+    bool UnhookFunction(uint32_t address);
+    TraceGraph CollectTraceGraph();
+    void ResetTrace();
+
+    std::vector<ModuleInfo> GetModules();
+    std::vector<ModuleLocation> ResolveAddresses(const std::vector<uint32_t>& addresses);
+    uint32_t LoadSymbols(std::string_view map);
+    std::string GetSymbolName(int32_t symbol);
+
+    void EnableCrashDump(CrashDumpSink sink, void* context);
+    void DisableCrashDump();
+    bool AddCrashDumpRange(uint32_t address, uint32_t size);
+    void ClearCrashDumpRanges();
+
+    bool StartHeapTracking();
+    void StopHeapTracking();
+    HeapReport CollectHeapReport(uint32_t minLeakAge = 0);
+    void ResetHeapTracking();
+
+    std::vector<LogRecord> DrainLog(uint32_t max = ~0u);
+    std::string FormatLogRecord(const LogRecord& record);
+    std::vector<LogFormat> GetLogFormats(const std::vector<LogRecord>& records);
+    uint32_t GetLogDropped();
+
+    ExceptionNesting GetExceptionNesting(uint32_t core);
+
+    uint32_t ReadMemory(uint32_t address, void* buffer, uint32_t size);
+    uint32_t WriteMemory(uint32_t address, const void* buffer, uint32_t size);
+
+    uint32_t ScanFirst(const std::vector<ScanRange>& ranges, ScanType type, ScanCompare compare, const std::vector<uint8_t>& value = {}, const std::vector<uint8_t>& mask = {}, uint32_t alignment = 0);
+    uint32_t ScanNext(ScanCompare compare, const std::vector<uint8_t>& value = {});
+    uint32_t GetScanCount();
+    std::vector<uint32_t> GetScanResults(uint32_t offset, uint32_t max);
+    void ResetScan();
+
+    uint32_t TakeSnapshot(const std::vector<ScanRange>& ranges, uint32_t blockSize = 0x1000);
+    std::vector<SnapshotChange> DiffSnapshot(bool captureData = false, bool update = true);
+    void ResetSnapshot();
 }
\ No newline at end of file
@@ -2,7 +2,6 @@
 
 #include <cstdint>
 #include <cstring>
-#include <coreinit/context.h>
 
 namespace Library::Debug
 {
@@ -15,6 +14,35 @@ namespace Library::Debug
         Bit64 = 8
     };
 
+    enum class BreakpointTarget : uint32_t
+    {
+        Instruction = 0,
+        Data = 1
+    };
+
+    // Executed by the exception handler on the interrupted context, in order,
+    // before the thread resumes.
+    enum class BreakpointActionType : uint32_t
+    {
+        SetGpr = 0,      // gpr[index] = value
+        SetFpr = 1,      // fpr[index] = fvalue
+        SetPc = 2,       // resume at value
+        Skip = 3,        // resume after the trapping instruction, a data access is suppressed
+        Return = 4,      // resume at lr, combine with SetGpr 3 to force a return value
+        Counter = 5,     // counter[index]++
+        WriteMemory = 6  // single store of size (1, 2 or 4) bytes of value at a data address
+    };
+
+    struct BreakpointAction
+    {
+        BreakpointActionType type;
+        uint32_t index;
+        uint32_t value;
+        double fvalue;
+        uint32_t address;
+        uint32_t size;
+    };
+
     struct RegisterInfo
     {
         uint32_t pc;
@@ -25,13 +53,15 @@ namespace Library::Debug
         uint32_t lr;
         uint32_t ctr;
 
-        static RegisterInfo fromContext(OSContext* context)
+        // Takes any OSContext-shaped type so this header stays free of coreinit
+        template<typename Context>
+        static RegisterInfo fromContext(const Context* context)
         {
             RegisterInfo info;
             info.pc = context->srr0;
             info.dar = context->dar;
-            std::memcpy(&info.gpr, context->gpr, 32);
-            std::memcpy(&info.fpr, context->fpr, 32);
+            std::memcpy(&info.gpr, context->gpr, sizeof(info.gpr));
+            std::memcpy(&info.fpr, context->fpr, sizeof(info.fpr));
             info.cr = context->cr;
             info.lr = context->lr;
             info.ctr = context->ctr;
@@ -0,0 +1,20 @@
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+namespace Library::Debug
+{
+    // Coverage bitmaps hold one bit per address of the sorted, deduplicated
+    // list returned by GetCoverageAddresses: bit (i % 32) of word (i / 32).
+    inline std::vector<uint32_t> CoverageDiff(const std::vector<uint32_t>& current, const std::vector<uint32_t>& baseline)
+    {
+        std::vector<uint32_t> diff(current.size());
+        for (uint32_t i = 0; i < current.size(); i++)
+        {
+            uint32_t base = i < baseline.size() ? baseline[i] : 0;
+            diff[i] = current[i] & ~base;
+        }
+        return diff;
+    }
+}
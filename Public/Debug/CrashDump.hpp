@@ -0,0 +1,91 @@
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace Library::Debug
+{
+    // Dump layout, all fields big-endian:
+    //   header : 'L' 'D' 'C' 'D' version:u16 flags:u16 size:u32 type:u32 core:u32 time:u64 reserved:u32
+    //   section: tag:u32 size:u32 payload[size] (size is a multiple of 4)
+    //     1 context: gpr[32]:u32 fpr[32]:u64 cr lr ctr xer srr0 srr1 dsisr dar:u32 fpscr:u64
+    //     2 stack  : count:u32 { sp:u32 lr:u32 }[count], back chain from r1
+    //     3 threads: count:u32 { address:u32 id:u16 state:u8 pad:u8 priority:i32 name[32] }[count]
+    //     4 memory : address:u32 size:u32 bytes[size] padded to 4
+    // flags bit 0 is set when the buffer filled up: the last memory range was
+    // cut short or later sections were dropped.
+    //
+    // The dump is staged in exception context, then the crashed thread leaves
+    // it and calls the sink on a separate stack right before OSFatal. The sink
+    // may do I/O, but the rest of the process is in whatever state the crash
+    // left it, so it should not depend on more than it has to.
+    using CrashDumpSink = void (*)(const uint8_t* data, uint32_t size, void* context);
+
+    static constexpr const uint32_t CRASH_DUMP_MAX_SIZE = 0x10000;
+
+    struct CrashContext
+    {
+        uint32_t gpr[32];
+        double fpr[32];
+        uint32_t cr;
+        uint32_t lr;
+        uint32_t ctr;
+        uint32_t xer;
+        uint32_t srr0;
+        uint32_t srr1;
+        uint32_t dsisr;
+        uint32_t dar;
+        uint64_t fpscr;
+    };
+
+    struct CrashFrame
+    {
+        uint32_t sp;
+        uint32_t lr;
+    };
+
+    struct CrashThread
+    {
+        uint32_t address;
+        uint16_t id;
+        uint8_t state;
+        int32_t priority;
+        std::string name;
+    };
+
+    struct CrashMemory
+    {
+        uint32_t address;
+        std::vector<uint8_t> data;
+    };
+
+    struct CrashDumpData
+    {
+        uint32_t type;
+        uint32_t core;
+        uint64_t time;
+        bool truncated;
+        CrashContext context;
+        std::vector<CrashFrame> stack;
+        std::vector<CrashThread> threads;
+        std::vector<CrashMemory> memory;
+    };
+
+    bool ReadCrashDump(const uint8_t* data, uint32_t size, CrashDumpData& out);
+
+    // Opened and grown to CRASH_DUMP_MAX_SIZE up front, e.g.
+    // "fs:/vol/external01/crash.bin" for the SD card on device, so the sink
+    // neither creates nor grows a file after the crash. Bytes past the header
+    // size are stale.
+    struct CrashDumpFile
+    {
+        int fd;
+    };
+
+    bool OpenCrashDumpFile(CrashDumpFile& file, const char* path);
+    void CloseCrashDumpFile(CrashDumpFile& file);
+
+    // Sink writing the dump to a file; context is an open CrashDumpFile*
+    void CrashDumpFileSink(const uint8_t* data, uint32_t size, void* context);
+}
@@ -0,0 +1,24 @@
+#pragma once
+
+#include <cstdint>
+
+#include <coreinit/thread.h>
+
+#include "Debug/Breakpoint.hpp"
+
+namespace Library::Debug
+{
+    // Called on the delivery thread; records are only valid during the call.
+    // Replacing or clearing a callback waits until the delivery thread no
+    // longer uses the previous one, so its context may be freed afterwards.
+    using BreakInfoCallback = void (*)(const RegisterInfo* records, uint32_t count, void* context);
+
+    struct DeliveryConfig
+    {
+        OSThreadAttributes affinity = OS_THREAD_ATTRIB_AFFINITY_ANY;
+        int32_t priority = 16;
+        uint32_t minSleep = 100;   // microseconds, used after every pass that delivered a batch
+        uint32_t maxSleep = 10000; // microseconds, the backoff doubles up to this while idle; worst case latency
+        uint32_t batch = 64;       // records per callback, at most 64
+    };
+}
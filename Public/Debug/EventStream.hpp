@@ -0,0 +1,65 @@
+#pragma once
+
+#include <cstdint>
+
+#include "Debug/Breakpoint.hpp"
+
+// Only depends on the standard library so the reader builds on the host.
+namespace Library::Debug
+{
+    // Stream layout (all multi-byte fixed fields big-endian):
+    //   header : 'L' 'D' 'E' 'S' version:u8 reserved:u8
+    //   frame  : length:u16 channel:u8 payload[length]
+    //   payload: fields:u8 [gprMask:uleb] [fprMask:uleb] misc... gpr... fpr...
+    // fields bit 0/1 flag the presence of the GPR/FPR masks, bits 2-6 flag
+    // changed pc, dar, cr, lr, ctr. Changed 32-bit registers are stored as
+    // zigzag LEB128 deltas and changed FPRs as raw 64-bit values, all
+    // relative to the previous record of the same channel.
+    struct EventRecord
+    {
+        uint8_t channel;
+        RegisterInfo info;
+    };
+
+    class EventWriter
+    {
+    public:
+        EventWriter(uint8_t* buffer, uint32_t capacity);
+
+        void Reset(uint8_t* buffer, uint32_t capacity); // continues the stream into a new buffer
+        bool Write(uint8_t channel, const RegisterInfo& info);
+
+        uint32_t Size() const;
+
+        static constexpr const uint8_t VERSION = 1;
+        static constexpr const uint32_t CHANNEL_COUNT = 16;
+        static constexpr const uint32_t HEADER_SIZE = 6;
+        static constexpr const uint32_t MAX_FRAME_SIZE = 3 + 1 + 5 + 5 + 5 * 5 + 32 * 5 + 32 * 8;
+
+    private:
+        uint32_t Encode(uint8_t* out, uint8_t channel, const RegisterInfo& info);
+
+        uint8_t* _buffer;
+        uint32_t _capacity;
+        uint32_t _size;
+        RegisterInfo _previous[CHANNEL_COUNT]{};
+    };
+
+    class EventReader
+    {
+    public:
+        EventReader(const uint8_t* data, uint32_t size);
+
+        void Reset(const uint8_t* data, uint32_t size); // continues the stream from a new buffer
+        bool Next(EventRecord& record);
+
+        bool Failed() const;
+
+    private:
+        const uint8_t* _data;
+        uint32_t _size;
+        uint32_t _offset;
+        bool _failed;
+        RegisterInfo _previous[EventWriter::CHANNEL_COUNT]{};
+    };
+}
@@ -0,0 +1,14 @@
+#pragma once
+
+#include <cstdint>
+
+namespace Library::Debug
+{
+    struct ExceptionNesting
+    {
+        uint32_t depth;    // handlers currently active on the core
+        uint32_t maxDepth; // deepest nesting seen
+        uint32_t nested;   // exceptions taken while another handler was active
+        uint32_t dropped;  // exceptions returned unhandled because the depth limit was reached
+    };
+}
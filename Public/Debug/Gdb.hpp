@@ -0,0 +1,136 @@
+#pragma once
+
+#include <cstdint>
+#include <deque>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "Debug/Breakpoint.hpp"
+
+namespace Library::Debug
+{
+    enum class GdbBreakpointType : uint32_t
+    {
+        Software = 0,  // Z0
+        Hardware = 1,  // Z1
+        Write = 2,     // Z2
+        Read = 3,      // Z3
+        Access = 4     // Z4
+    };
+
+    struct GdbStop
+    {
+        GdbBreakpointType type;
+        RegisterInfo info;
+    };
+
+    struct GdbThread
+    {
+        uint32_t id;
+        std::string name;
+    };
+
+    class GdbTransport
+    {
+    public:
+        virtual ~GdbTransport() = default;
+
+        // > 0: bytes read, 0: nothing available, < 0: connection closed
+        virtual int32_t Read(void* buffer, uint32_t size) = 0;
+        virtual bool Write(const void* data, uint32_t size) = 0;
+    };
+
+    class GdbTarget
+    {
+    public:
+        virtual ~GdbTarget() = default;
+
+        virtual uint32_t ReadMemory(uint32_t address, void* buffer, uint32_t size) = 0;
+        virtual uint32_t WriteMemory(uint32_t address, const void* buffer, uint32_t size) = 0;
+
+        virtual bool InsertBreakpoint(GdbBreakpointType type, uint32_t address, uint32_t length) = 0;
+        virtual bool RemoveBreakpoint(GdbBreakpointType type, uint32_t address, uint32_t length) = 0;
+
+        virtual bool PollStop(GdbStop& stop) = 0;
+        virtual std::vector<GdbThread> Threads() = 0;
+    };
+
+    // Non-blocking transport over a connected stream socket
+    class SocketTransport : public GdbTransport
+    {
+    public:
+        explicit SocketTransport(int socket);
+
+        int32_t Read(void* buffer, uint32_t size) override;
+        bool Write(const void* data, uint32_t size) override;
+
+    private:
+        bool WaitWritable();
+
+        int _socket;
+    };
+
+    // Target backed by BreakpointManager, Memory and Thread
+    class DeviceTarget : public GdbTarget
+    {
+    public:
+        uint32_t ReadMemory(uint32_t address, void* buffer, uint32_t size) override;
+        uint32_t WriteMemory(uint32_t address, const void* buffer, uint32_t size) override;
+
+        bool InsertBreakpoint(GdbBreakpointType type, uint32_t address, uint32_t length) override;
+        bool RemoveBreakpoint(GdbBreakpointType type, uint32_t address, uint32_t length) override;
+
+        bool PollStop(GdbStop& stop) override;
+        std::vector<GdbThread> Threads() override;
+
+    private:
+        std::deque<GdbStop> _pending;
+        GdbBreakpointType _dataType = GdbBreakpointType::Write;
+        uint32_t _instructionAddress = 0;
+        uint32_t _dataAddress = 0;
+    };
+
+    // The library records hits without halting the game, so the "stopped"
+    // register state served to GDB is the snapshot of the latest hit while
+    // memory accesses always see live memory.
+    class GdbServer
+    {
+    public:
+        GdbServer(GdbTransport& transport, GdbTarget& target);
+
+        bool Poll(); // returns false once the client detached or the transport closed
+
+    private:
+        void Parse();
+        void HandlePacket(std::string_view packet);
+        void HandleQuery(std::string_view packet);
+        void HandleBreakpoint(std::string_view packet, bool insert);
+        void HandleReadMemory(std::string_view packet, bool binary);
+        void HandleWriteMemory(std::string_view packet, bool binary);
+        void HandleThreads(std::string_view annex);
+
+        void SendPacket(std::string_view payload);
+        void SendStop(const GdbStop& stop);
+        void Flush();
+
+        std::string Register(uint32_t number) const;
+
+        GdbTransport& _transport;
+        GdbTarget& _target;
+
+        std::string _input;
+        std::string _output;
+        std::string _lastPacket;
+        std::string _threadsXml;
+
+        GdbStop _stop{};
+        bool _running = false;
+        bool _noAck = false;
+        bool _connected = true;
+        bool _discarding = false; // inside a packet over PACKET_SIZE
+
+        static constexpr const uint32_t PACKET_SIZE = 0x4000;
+        static constexpr const uint32_t REGISTER_COUNT = 71;
+    };
+}
@@ -0,0 +1,38 @@
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+namespace Library::Debug
+{
+    static constexpr const uint32_t HEAP_STACK_DEPTH = 4;
+
+    struct HeapSite
+    {
+        uint32_t stack;                    // hash of frames, stable for the session
+        uint32_t frames[HEAP_STACK_DEPTH]; // return addresses, frames[0] is the direct caller
+        uint32_t allocations;
+        uint32_t frees;
+        uint64_t allocatedBytes;
+        uint32_t liveCount;
+        uint64_t liveBytes;
+        double rate; // allocations per second since tracking started
+    };
+
+    struct HeapLeak
+    {
+        uint32_t address;
+        uint32_t size;
+        uint32_t stack;
+        uint64_t age; // microseconds
+    };
+
+    struct HeapReport
+    {
+        std::vector<HeapSite> sites; // hottest first
+        std::vector<HeapLeak> leaks; // oldest first
+        uint64_t liveBytes;
+        uint32_t liveCount;
+        uint32_t dropped; // events lost on full buffers, leaks may be overreported
+    };
+}
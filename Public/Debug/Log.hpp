@@ -0,0 +1,85 @@
+#pragma once
+
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <type_traits>
+
+// Only depends on the standard library so records can be formatted on the host.
+namespace Library::Debug
+{
+    static constexpr const uint32_t LOG_MAX_ARGS = 6;
+
+    enum class LogArgType : uint16_t
+    {
+        Word = 0,   // up to 32 bit integers and pointers
+        Long = 1,   // 64 bit integers
+        Double = 2,
+    };
+
+    // One deferred log call, fixed width so raw records can be shipped to a
+    // host. format (and any %s argument) is only stored as a device address,
+    // so both must outlive the record: use string literals.
+    struct LogRecord
+    {
+        uint64_t time;
+        uint32_t core;
+        uint32_t thread;
+        uint32_t format;
+        uint16_t count;
+        uint16_t types; // 2 bits per argument, LogArgType
+        uint64_t args[LOG_MAX_ARGS];
+    };
+    static_assert(sizeof(LogRecord) == 72, "LogRecord layout must not depend on the target");
+
+    // Format string of a record, see GetLogFormats.
+    struct LogFormat
+    {
+        uint32_t address;
+        std::string text;
+    };
+
+    // Formats record with format, the string found at record.format. A %s
+    // argument is only dereferenced when strings is set, which is valid on
+    // the device alone; otherwise it prints as its address.
+    std::string FormatLogRecord(const LogRecord& record, const char* format, bool strings = false);
+
+    void LogPush(const char* format, uint32_t count, uint32_t types, const uint64_t* args);
+
+    template<typename T>
+    constexpr LogArgType LogTypeOf()
+    {
+        if constexpr (std::is_floating_point_v<T>) return LogArgType::Double;
+        else if constexpr (sizeof(T) > 4) return LogArgType::Long;
+        else return LogArgType::Word;
+    }
+
+    template<typename T>
+    uint64_t LogEncode(T value)
+    {
+        if constexpr (std::is_floating_point_v<T>)
+        {
+            double d = value;
+            uint64_t bits;
+            std::memcpy(&bits, &d, sizeof(bits));
+            return bits;
+        }
+        else if constexpr (std::is_pointer_v<T>) return reinterpret_cast<uintptr_t>(value);
+        else return static_cast<uint64_t>(value);
+    }
+
+    // printf style, formatting is deferred to FormatLogRecord. Safe to call
+    // from exception handlers: no locks, no allocation.
+    template<typename... Args>
+    void Log(const char* format, Args... args)
+    {
+        static_assert(sizeof...(Args) <= LOG_MAX_ARGS, "too many log arguments");
+        static_assert(((std::is_arithmetic_v<Args> || std::is_enum_v<Args> || std::is_pointer_v<Args>) && ...), "unsupported log argument");
+
+        uint64_t values[LOG_MAX_ARGS] = { LogEncode(args)... };
+        uint32_t types = 0;
+        [[maybe_unused]] uint32_t shift = 0;
+        ((types |= static_cast<uint32_t>(LogTypeOf<Args>()) << shift, shift += 2), ...);
+        LogPush(format, sizeof...(Args), types, values);
+    }
+}
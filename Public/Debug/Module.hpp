@@ -0,0 +1,40 @@
+#pragma once
+
+#include <cstdint>
+#include <string>
+
+namespace Library::Debug
+{
+    enum class ModuleSection : uint32_t
+    {
+        None = 0,
+        Text = 1,
+        Data = 2,
+        Read = 3
+    };
+
+    struct ModuleInfo
+    {
+        std::string name;
+        uint32_t textBegin;
+        uint32_t textSize;
+        uint32_t dataBegin;
+        uint32_t dataSize;
+        uint32_t readBegin;
+        uint32_t readSize;
+    };
+
+    // module indexes GetModules() and stays valid until an RPL is loaded or
+    // unloaded; symbol indexes the table given to LoadSymbols and is only set
+    // when the address lies within the symbol's size. Both are -1 when
+    // unresolved.
+    struct ModuleLocation
+    {
+        uint32_t address;
+        int32_t module;
+        ModuleSection section;
+        uint32_t offset;
+        int32_t symbol;
+        uint32_t symbolOffset;
+    };
+}
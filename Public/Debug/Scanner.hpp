@@ -0,0 +1,36 @@
+#pragma once
+
+#include <cstdint>
+
+namespace Library::Debug
+{
+    enum class ScanType : uint32_t
+    {
+        U8 = 0,
+        U16 = 1,
+        U32 = 2,
+        U64 = 3,
+        Float = 4,
+        Double = 5,
+        Bytes = 6
+    };
+
+    enum class ScanCompare : uint32_t
+    {
+        Unknown = 0,   // first scan only: keep every slot
+        Equal = 1,
+        NotEqual = 2,
+        Greater = 3,
+        Less = 4,
+        Changed = 5,   // rescan only: compare against previous value
+        Unchanged = 6,
+        Increased = 7,
+        Decreased = 8
+    };
+
+    struct ScanRange
+    {
+        uint32_t begin;
+        uint32_t end;
+    };
+}
@@ -0,0 +1,14 @@
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+namespace Library::Debug
+{
+    struct SnapshotChange
+    {
+        uint32_t address;
+        uint32_t size;
+        std::vector<uint8_t> data; // current contents, only when captured and readable
+    };
+}
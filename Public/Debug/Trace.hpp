@@ -0,0 +1,30 @@
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+namespace Library::Debug
+{
+    struct TraceNode
+    {
+        uint32_t address;
+        uint32_t calls;
+        uint64_t inclusive; // microseconds
+        uint64_t exclusive; // microseconds
+    };
+
+    struct TraceEdge
+    {
+        uint32_t caller; // 0 for calls made outside any hooked function
+        uint32_t callee;
+        uint32_t calls;
+        uint64_t inclusive; // microseconds
+    };
+
+    struct TraceGraph
+    {
+        std::vector<TraceNode> nodes;
+        std::vector<TraceEdge> edges;
+        uint32_t dropped;
+    };
+}
@@ -0,0 +1,17 @@
+#pragma once
+
+#include <cstdint>
+
+namespace Library::Debug
+{
+    struct WatchStat
+    {
+        uint32_t address;
+        uint32_t size;
+        uint32_t hits;
+        uint64_t exposure; // microseconds the DABR was armed on this address
+        double rate;       // estimated accesses per second while exposed
+        uint32_t lastPc;
+        uint32_t lastLr;
+    };
+}
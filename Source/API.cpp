@@ -1,4 +1,15 @@
 #include "Breakpoint.hpp"
+#include "Scanner.hpp"
+#include "Snapshot.hpp"
+#include "Memory.hpp"
+#include "WatchSet.hpp"
+#include "Coverage.hpp"
+#include "Trace.hpp"
+#include "ModuleMap.hpp"
+#include "CrashDump.hpp"
+#include "HeapTracker.hpp"
+#include "BinaryLog.hpp"
+#include "Delivery.hpp"
 #include "Debug/Breakpoint.hpp"
 #include "Debug.hpp"
 #include "Syscall.hpp"
@@ -13,6 +24,9 @@ namespace Library::Debug
     {
         Exception::Initialize();
         BreakpointManager::Initialize();
+        Coverage::Initialize();
+        ModuleMap::Initialize();
+        HeapTracker::Initialize();
 
         KernelPatchSyscall(0xC0, reinterpret_cast<uint32_t>(&SC_SetDABR));
         KernelPatchSyscall(0xC1, reinterpret_cast<uint32_t>(&SC_SetIABR));
@@ -20,7 +34,14 @@ namespace Library::Debug
 
     void Shutdown()
     {
+        Delivery::Stop();
+        WatchSet::Clear();
+        Coverage::Stop();
+        HeapTracker::Stop();
         BreakpointManager::Shutdown();
+        ModuleMap::Shutdown();
+        Scanner::Reset();
+        Snapshot::Reset();
     }
 
     void SetDataBreakpoint(uint32_t address, bool read, bool write, BreakpointSize size)
@@ -56,4 +77,261 @@ namespace Library::Debug
     {
         return BreakpointManager::ConsumeInstructionBreakInfo();
     }
+
+    bool StartDelivery(const DeliveryConfig& config)
+    {
+        if(!BreakpointManager::IsInitialized()) return false;
+        return Delivery::Start(config);
+    }
+
+    void StopDelivery()
+    {
+        Delivery::Stop();
+    }
+
+    void SetDataBreakCallback(BreakInfoCallback callback, void* context)
+    {
+        Delivery::SetDataCallback(callback, context);
+    }
+
+    void SetInstructionBreakCallback(BreakInfoCallback callback, void* context)
+    {
+        Delivery::SetInstructionCallback(callback, context);
+    }
+
+    bool SetBreakpointActions(BreakpointTarget target, const std::vector<BreakpointAction>& actions)
+    {
+        if(!BreakpointManager::IsInitialized()) return false;
+        return BreakpointManager::SetActions(target, actions);
+    }
+
+    void ClearBreakpointActions(BreakpointTarget target)
+    {
+        BreakpointManager::ClearActions(target);
+    }
+
+    uint32_t GetBreakpointCounter(uint32_t index)
+    {
+        return BreakpointManager::Counter(index);
+    }
+
+    void ResetBreakpointCounters()
+    {
+        BreakpointManager::ResetCounters();
+    }
+
+    bool AddWatch(uint32_t address, bool read, bool write, BreakpointSize size)
+    {
+        if(!BreakpointManager::IsInitialized()) return false;
+        return WatchSet::Add(address, read, write, size);
+    }
+
+    bool RemoveWatch(uint32_t address)
+    {
+        return WatchSet::Remove(address);
+    }
+
+    void ClearWatches()
+    {
+        WatchSet::Clear();
+    }
+
+    void SetWatchSliceTime(uint32_t microseconds)
+    {
+        WatchSet::SetSliceTime(microseconds);
+    }
+
+    std::vector<WatchStat> GetWatchStats()
+    {
+        return WatchSet::Stats();
+    }
+
+    uint32_t StartCoverage(const std::vector<uint32_t>& addresses)
+    {
+        if(!BreakpointManager::IsInitialized()) return 0;
+        return Coverage::Start(addresses);
+    }
+
+    void StopCoverage()
+    {
+        Coverage::Stop();
+    }
+
+    std::vector<uint32_t> GetCoverageAddresses()
+    {
+        return Coverage::Addresses();
+    }
+
+    std::vector<uint32_t> GetCoverageBitmap()
+    {
+        return Coverage::Bitmap();
+    }
+
+    uint32_t GetCoverageHitCount()
+    {
+        return Coverage::HitCount();
+    }
+
+    bool HookFunction(uint32_t address)
+    {
+        if(!BreakpointManager::IsInitialized()) return false;
+        return Trace::Hook(address);
+    }
+
+    bool UnhookFunction(uint32_t address)
+    {
+        if(!BreakpointManager::IsInitialized()) return false;
+        return Trace::Unhook(address);
+    }
+
+    TraceGraph CollectTraceGraph()
+    {
+        return Trace::Collect();
+    }
+
+    void ResetTrace()
+    {
+        Trace::Reset();
+    }
+
+    std::vector<ModuleInfo> GetModules()
+    {
+        return ModuleMap::Modules();
+    }
+
+    std::vector<ModuleLocation> ResolveAddresses(const std::vector<uint32_t>& addresses)
+    {
+        return ModuleMap::Resolve(addresses);
+    }
+
+    uint32_t LoadSymbols(std::string_view map)
+    {
+        return ModuleMap::LoadSymbols(map);
+    }
+
+    std::string GetSymbolName(int32_t symbol)
+    {
+        return ModuleMap::SymbolName(symbol);
+    }
+
+    void EnableCrashDump(CrashDumpSink sink, void* context)
+    {
+        CrashDump::Enable(sink, context);
+    }
+
+    void DisableCrashDump()
+    {
+        CrashDump::Disable();
+    }
+
+    bool AddCrashDumpRange(uint32_t address, uint32_t size)
+    {
+        return CrashDump::AddRange(address, size);
+    }
+
+    void ClearCrashDumpRanges()
+    {
+        CrashDump::ClearRanges();
+    }
+
+    bool StartHeapTracking()
+    {
+        if(!BreakpointManager::IsInitialized()) return false;
+        return HeapTracker::Start();
+    }
+
+    void StopHeapTracking()
+    {
+        HeapTracker::Stop();
+    }
+
+    HeapReport CollectHeapReport(uint32_t minLeakAge)
+    {
+        if(!BreakpointManager::IsInitialized()) return {};
+        return HeapTracker::Collect(minLeakAge);
+    }
+
+    void ResetHeapTracking()
+    {
+        if(!BreakpointManager::IsInitialized()) return;
+        HeapTracker::Reset();
+    }
+
+    std::vector<LogRecord> DrainLog(uint32_t max)
+    {
+        return BinaryLog::Drain(max);
+    }
+
+    std::string FormatLogRecord(const LogRecord& record)
+    {
+        return BinaryLog::Format(record);
+    }
+
+    std::vector<LogFormat> GetLogFormats(const std::vector<LogRecord>& records)
+    {
+        return BinaryLog::Formats(records);
+    }
+
+    uint32_t GetLogDropped()
+    {
+        return BinaryLog::Dropped();
+    }
+
+    ExceptionNesting GetExceptionNesting(uint32_t core)
+    {
+        return Exception::GetNesting(core);
+    }
+
+    uint32_t ReadMemory(uint32_t address, void* buffer, uint32_t size)
+    {
+        if(!BreakpointManager::IsInitialized()) return 0;
+        return Memory::Read(address, buffer, size);
+    }
+
+    uint32_t WriteMemory(uint32_t address, const void* buffer, uint32_t size)
+    {
+        if(!BreakpointManager::IsInitialized()) return 0;
+        return Memory::Write(address, buffer, size);
+    }
+
+    uint32_t ScanFirst(const std::vector<ScanRange>& ranges, ScanType type, ScanCompare compare, const std::vector<uint8_t>& value, const std::vector<uint8_t>& mask, uint32_t alignment)
+    {
+        return Scanner::First(ranges, type, compare, value, mask, alignment);
+    }
+
+    uint32_t ScanNext(ScanCompare compare, const std::vector<uint8_t>& value)
+    {
+        return Scanner::Next(compare, value);
+    }
+
+    uint32_t GetScanCount()
+    {
+        return Scanner::Count();
+    }
+
+    std::vector<uint32_t> GetScanResults(uint32_t offset, uint32_t max)
+    {
+        return Scanner::Results(offset, max);
+    }
+
+    void ResetScan()
+    {
+        Scanner::Reset();
+    }
+
+    uint32_t TakeSnapshot(const std::vector<ScanRange>& ranges, uint32_t blockSize)
+    {
+        return Snapshot::Take(ranges, blockSize);
+    }
+
+    std::vector<SnapshotChange> DiffSnapshot(bool captureData, bool update)
+    {
+        if(!BreakpointManager::IsInitialized()) return {};
+        return Snapshot::Diff(captureData, update);
+    }
+
+    void ResetSnapshot()
+    {
+        Snapshot::Reset();
+    }
 }
\ No newline at end of file
@@ -0,0 +1,87 @@
+#include <algorithm>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include <coreinit/core.h>
+#include <coreinit/thread.h>
+#include <coreinit/time.h>
+
+#include "BinaryLog.hpp"
+#include "Debug/Log.hpp"
+
+namespace Library::Debug
+{
+    void LogPush(const char* format, uint32_t count, uint32_t types, const uint64_t* args)
+    {
+        BinaryLog::Push(format, count, types, args);
+    }
+
+    void BinaryLog::Push(const char* format, uint32_t count, uint32_t types, const uint64_t* args)
+    {
+        uint32_t core = OSGetCoreId();
+        if (core >= CORE_COUNT || count > LOG_MAX_ARGS) return;
+
+        LogRecord record;
+        record.time = static_cast<uint64_t>(OSGetSystemTime());
+        record.core = core;
+        record.thread = reinterpret_cast<uint32_t>(OSGetCurrentThread());
+        record.format = reinterpret_cast<uint32_t>(format);
+        record.count = static_cast<uint16_t>(count);
+        record.types = static_cast<uint16_t>(types);
+        for (uint32_t i = 0; i < LOG_MAX_ARGS; i++) record.args[i] = i < count ? args[i] : 0;
+
+        if (!rings[core].push(record)) dropped.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    // Records of the three cores are merged by timebase, also across calls
+    // with a max. At most one full set of rings is taken per call so the
+    // vector never grows while the lock is held.
+    std::vector<LogRecord> BinaryLog::Drain(uint32_t max)
+    {
+        uint32_t limit = std::min(max, CORE_COUNT * RING_SIZE);
+        std::vector<LogRecord> records;
+        records.reserve(limit);
+
+        drainMutex.lock();
+        while (records.size() < limit)
+        {
+            uint32_t next = CORE_COUNT;
+            for (uint32_t core = 0; core < CORE_COUNT; core++)
+            {
+                if (!held[core]) held[core] = rings[core].pop(heads[core]);
+                if (held[core] && (next == CORE_COUNT || heads[core].time < heads[next].time)) next = core;
+            }
+            if (next == CORE_COUNT) break;
+
+            records.push_back(heads[next]);
+            held[next] = false;
+        }
+        drainMutex.unlock();
+        return records;
+    }
+
+    uint32_t BinaryLog::Dropped()
+    {
+        return dropped.load();
+    }
+
+    std::string BinaryLog::Format(const LogRecord& record)
+    {
+        return FormatLogRecord(record, reinterpret_cast<const char*>(record.format), true);
+    }
+
+    // One entry per distinct format, for a host that only receives records
+    std::vector<LogFormat> BinaryLog::Formats(const std::vector<LogRecord>& records)
+    {
+        std::vector<LogFormat> formats;
+        for (const LogRecord& record : records)
+        {
+            if (!record.format) continue;
+            auto same = [&](const LogFormat& format) { return format.address == record.format; };
+            if (std::find_if(formats.begin(), formats.end(), same) != formats.end()) continue;
+            formats.push_back({ record.format, reinterpret_cast<const char*>(record.format) });
+        }
+        return formats;
+    }
+}
@@ -1,13 +1,15 @@
 #include <cstdint>
 
+#include <coreinit/core.h>
 #include <coreinit/debug.h>
-#include <coreinit/memorymap.h>
 #include <vector>
 
 #include "Breakpoint.hpp"
 #include "Debug/Breakpoint.hpp"
 #include "Syscall.hpp"
 #include "Exception.hpp"
+#include "Memory.hpp"
+#include "WatchSet.hpp"
 #include "coreinit/exception.h"
 
 namespace Library::Debug
@@ -80,6 +82,125 @@ namespace Library::Debug
         return vector;
     }
 
+    uint32_t BreakpointManager::DrainDataBreakInfo(RegisterInfo* out, uint32_t max)
+    {
+        uint32_t count = 0;
+        while (count < max && dInfoBuffer.pop(out[count])) count++;
+        return count;
+    }
+
+    uint32_t BreakpointManager::DrainInstructionBreakInfo(RegisterInfo* out, uint32_t max)
+    {
+        uint32_t count = 0;
+        while (count < max && iInfoBuffer.pop(out[count])) count++;
+        return count;
+    }
+
+    BreakpointManager::ActionList& BreakpointManager::Actions(BreakpointTarget target)
+    {
+        return target == BreakpointTarget::Data ? dActions : iActions;
+    }
+
+    // Everything is validated here; the handler still bounds-checks indices.
+    bool BreakpointManager::SetActions(BreakpointTarget target, const std::vector<BreakpointAction>& actions)
+    {
+        if (actions.size() > MAX_ACTIONS) return false;
+        for (const BreakpointAction& action : actions)
+        {
+            switch (action.type)
+            {
+                case BreakpointActionType::SetGpr:
+                case BreakpointActionType::SetFpr:
+                    if (action.index >= 32) return false;
+                    break;
+                case BreakpointActionType::SetPc:
+                    if (action.value & 3) return false;
+                    break;
+                case BreakpointActionType::Skip:
+                case BreakpointActionType::Return:
+                    break;
+                case BreakpointActionType::Counter:
+                    if (action.index >= MAX_COUNTERS) return false;
+                    break;
+                case BreakpointActionType::WriteMemory:
+                    if (action.size != 1 && action.size != 2 && action.size != 4) return false;
+                    if (action.address & (action.size - 1)) return false;
+                    if (Memory::IsCodeAddress(action.address)) return false; // no kernel copy in the handler
+                    break;
+                default:
+                    return false;
+            }
+        }
+
+        PublishActions(Actions(target), actions.data(), actions.size());
+        return true;
+    }
+
+    void BreakpointManager::ClearActions(BreakpointTarget target)
+    {
+        PublishActions(Actions(target), nullptr, 0);
+    }
+
+    // Waits for handlers still running the inactive set, which only takes as
+    // long as one list run.
+    void BreakpointManager::PublishActions(ActionList& list, const BreakpointAction* actions, uint32_t count)
+    {
+        actionMutex.lock();
+        uint32_t next = list.current.load(std::memory_order_relaxed) ^ 1;
+        while (list.readers[next].load(std::memory_order_acquire) != 0) {}
+
+        ActionSet& set = list.sets[next];
+        for (uint32_t i = 0; i < count; i++) set.actions[i] = actions[i];
+        set.count = count;
+        list.current.store(next, std::memory_order_release);
+        actionMutex.unlock();
+    }
+
+    uint32_t BreakpointManager::Counter(uint32_t index)
+    {
+        return index < MAX_COUNTERS ? counters[index].load() : 0;
+    }
+
+    void BreakpointManager::ResetCounters()
+    {
+        for (std::atomic<uint32_t>& counter : counters) counter.store(0);
+    }
+
+    // Runs in exception context on the interrupted thread's registers. The
+    // set is pinned by its reader count; current is checked again after
+    // pinning in case a writer picked the same set in between.
+    void BreakpointManager::RunActions(ActionList& list, OSContext* context)
+    {
+        uint32_t current;
+        while (true)
+        {
+            current = list.current.load(std::memory_order_acquire);
+            list.readers[current].fetch_add(1, std::memory_order_acq_rel);
+            if (list.current.load(std::memory_order_acquire) == current) break;
+            list.readers[current].fetch_sub(1, std::memory_order_release);
+        }
+
+        const ActionSet& set = list.sets[current];
+        uint32_t count = set.count < MAX_ACTIONS ? set.count : MAX_ACTIONS;
+        for (uint32_t i = 0; i < count; i++)
+        {
+            const BreakpointAction& action = set.actions[i];
+            switch (action.type)
+            {
+                case BreakpointActionType::SetGpr: if (action.index < 32) context->gpr[action.index] = action.value; break;
+                case BreakpointActionType::SetFpr: if (action.index < 32) context->fpr[action.index] = action.fvalue; break;
+                case BreakpointActionType::SetPc: context->srr0 = action.value; break;
+                case BreakpointActionType::Skip: context->srr0 += 4; break;
+                case BreakpointActionType::Return: context->srr0 = context->lr; break;
+                case BreakpointActionType::Counter: if (action.index < MAX_COUNTERS) counters[action.index].fetch_add(1, std::memory_order_relaxed); break;
+                case BreakpointActionType::WriteMemory: Memory::Store(action.address, action.value, action.size); break;
+                default: break;
+            }
+        }
+
+        list.readers[current].fetch_sub(1, std::memory_order_release);
+    }
+
     OSSwitchThreadCallbackFn OSSwitchThreadCallbackDefault = reinterpret_cast<OSSwitchThreadCallbackFn>(0x0103C4B4);
 
     void BreakpointManager::Initialize()
@@ -113,6 +234,11 @@ namespace Library::Debug
         ::SetIABR(value);
     }
 
+    uint32_t BreakpointManager::CurrentDABR()
+    {
+        return WatchSet::IsActive() ? WatchSet::Armed(OSGetCoreId()) : dabr.load();
+    }
+
     void BreakpointManager::SetSwitchThreadCallback(OSSwitchThreadCallbackFn function)
     {
         OSSetSwitchThreadCallback(function);
@@ -121,7 +247,7 @@ namespace Library::Debug
     BOOL BreakpointManager::DSIHandler(OSContext* context)
     {
         if (!context) return FALSE;
-        if ((context->dsisr & (MATCH_DABR_BIT)) == 0) return FALSE;
+        if ((context->dsisr & (MATCH_DABR_BIT)) == 0) return Memory::DSIHandler(context);
         
         uint32_t dar = context->dar;
 
@@ -129,10 +255,15 @@ namespace Library::Debug
         uint32_t begin = dBreakpointAddress.load();
         uint32_t end = begin + size;
         
-        if((begin <= dar && dar < end))
+        if(WatchSet::IsActive())
+        {
+            WatchSet::Record(context);
+        }
+        else if((begin <= dar && dar < end))
         {
             auto info = RegisterInfo::fromContext(context);
             dInfoBuffer.push(info);
+            RunActions(dActions, context);
         }
     
         SetDABR(0);
@@ -152,6 +283,7 @@ namespace Library::Debug
         {
             auto info = RegisterInfo::fromContext(context);
             iInfoBuffer.push(info);
+            RunActions(iActions, context);
         }
     
         SetIABR(0);
@@ -163,7 +295,7 @@ namespace Library::Debug
     {
         if(context->srr1 & SINGLE_STEP_BIT)
         {
-            SetDABR(dabr.load());
+            SetDABR(CurrentDABR());
             SetIABR(iabr.load());
             context->srr1 &= ~SINGLE_STEP_BIT;
             return TRUE;
@@ -178,15 +310,29 @@ namespace Library::Debug
     {
         if (!thread) return;
 
-        uint32_t d = dabr.load();
         uint32_t i = iabr.load();
         uint32_t addr = reinterpret_cast<uint32_t>(thread);
+        uint32_t core = OSGetCoreId();
 
-        uint32_t dPrev = 0;
-        if(!dMap.try_get(addr, dPrev) || dPrev != d)
+        // DABR is per core while dMap caches per thread, so a rotating watch
+        // set is always armed and the cache is bypassed until the core is
+        // back on the plain data breakpoint
+        if(WatchSet::IsActive())
+        {
+            SetDABR(WatchSet::Arm(core));
+            if (core < 3) watchArmed[core] = true;
+        }
+        else
         {
-            SetDABR(d);
-            dMap.insert(addr, d);
+            uint32_t d = dabr.load();
+            uint32_t dPrev = 0;
+            bool stale = core < 3 && watchArmed[core];
+            if(stale || !dMap.try_get(addr, dPrev) || dPrev != d)
+            {
+                SetDABR(d);
+                dMap.insert(addr, d);
+                if (core < 3) watchArmed[core] = false;
+            }
         }
 
         uint32_t iPrev = 0;
@@ -0,0 +1,136 @@
+#include <algorithm>
+#include <bit>
+#include <cstdint>
+#include <vector>
+
+#include <coreinit/exception.h>
+
+#include "Coverage.hpp"
+#include "Exception.hpp"
+#include "Memory.hpp"
+
+namespace Library::Debug
+{
+    void Coverage::Initialize()
+    {
+        Exception::SetCallback(OS_EXCEPTION_TYPE_PROGRAM, ProgramHandler);
+    }
+
+    uint32_t Coverage::Start(const std::vector<uint32_t>& list)
+    {
+        Stop();
+
+        auto next = std::make_unique<Table>();
+        std::vector<uint32_t>& addresses = next->addresses;
+        addresses = list;
+        std::sort(addresses.begin(), addresses.end());
+        addresses.erase(std::unique(addresses.begin(), addresses.end()), addresses.end());
+        std::erase_if(addresses, [](uint32_t address) { return (address & 3) != 0; });
+
+        uint32_t words = (addresses.size() + 31) / 32;
+        next->bitmap = std::make_unique<std::atomic<uint32_t>[]>(words);
+        for (uint32_t i = 0; i < words; i++) next->bitmap[i].store(0);
+
+        next->originals.assign(addresses.size(), 0);
+        for (uint32_t i = 0; i < addresses.size(); i++)
+        {
+            // unreadable addresses are marked like existing traps and never planted
+            if (Memory::Read(addresses[i], &next->originals[i], sizeof(uint32_t)) != sizeof(uint32_t)) next->originals[i] = TRAP_INSTRUCTION;
+        }
+
+        // The table two sessions back is unpublished first and only freed once
+        // no handler holds it; late traps of the last session still resolve.
+        previous.store(owned.get());
+        table.store(next.get());
+        while (readers.load(std::memory_order_acquire) != 0) {}
+        retired = std::move(owned);
+        owned = std::move(next);
+        active.store(true);
+
+        uint32_t planted = 0;
+        for (uint32_t i = 0; i < owned->addresses.size(); i++)
+        {
+            uint32_t trap = TRAP_INSTRUCTION;
+            if (owned->originals[i] == TRAP_INSTRUCTION) continue;
+            if (Memory::Write(owned->addresses[i], &trap, sizeof(trap)) == sizeof(trap)) planted++;
+        }
+        return planted;
+    }
+
+    // The table stays published after the restore: a thread that fetched a
+    // trap just before it was removed still resolves in the handler.
+    void Coverage::Stop()
+    {
+        if (!active.load()) return;
+
+        Table* current = table.load();
+        for (uint32_t i = 0; i < current->addresses.size(); i++)
+        {
+            if (current->bitmap[i / 32].load() & (1u << (i % 32))) continue;
+            if (current->originals[i] == TRAP_INSTRUCTION) continue;
+            Memory::Write(current->addresses[i], &current->originals[i], sizeof(uint32_t));
+        }
+
+        active.store(false);
+    }
+
+    std::vector<uint32_t> Coverage::Addresses()
+    {
+        Table* current = table.load();
+        return current ? current->addresses : std::vector<uint32_t>{};
+    }
+
+    std::vector<uint32_t> Coverage::Bitmap()
+    {
+        Table* current = table.load();
+        if (!current) return {};
+
+        std::vector<uint32_t> vector((current->addresses.size() + 31) / 32);
+        for (uint32_t i = 0; i < vector.size(); i++) vector[i] = current->bitmap[i].load();
+        return vector;
+    }
+
+    uint32_t Coverage::HitCount()
+    {
+        Table* current = table.load();
+        if (!current) return 0;
+
+        uint32_t count = 0;
+        uint32_t words = (current->addresses.size() + 31) / 32;
+        for (uint32_t i = 0; i < words; i++) count += std::popcount(current->bitmap[i].load());
+        return count;
+    }
+
+    // Rewriting the original goes through the kernel copy syscall and cache
+    // maintenance only, the same kind of work as SetIABR in the breakpoint
+    // handler: no locks, no allocation.
+    bool Coverage::Resolve(Table* current, OSContext* context)
+    {
+        if (!current) return false;
+
+        uint32_t pc = context->srr0;
+        auto it = std::lower_bound(current->addresses.begin(), current->addresses.end(), pc);
+        if (it == current->addresses.end() || *it != pc) return false;
+
+        uint32_t index = it - current->addresses.begin();
+        if (current->originals[index] == TRAP_INSTRUCTION) return false;
+
+        current->bitmap[index / 32].fetch_or(1u << (index % 32));
+        Memory::Write(pc, &current->originals[index], sizeof(uint32_t));
+        return true;
+    }
+
+    // Each trap removes itself on the first hit, so a covered block costs
+    // nothing afterwards. Traps not planted by us stay fatal. Listed
+    // addresses are resolved whether or not a session is running.
+    BOOL Coverage::ProgramHandler(OSContext* context)
+    {
+        if (!context) return FALSE;
+        if ((context->srr1 & TRAP_BIT) == 0) return FALSE;
+
+        readers.fetch_add(1, std::memory_order_acq_rel);
+        bool resolved = Resolve(table.load(), context) || Resolve(previous.load(), context);
+        readers.fetch_sub(1, std::memory_order_release);
+        return resolved ? TRUE : FALSE;
+    }
+}
@@ -0,0 +1,271 @@
+#include <cstdint>
+#include <cstring>
+
+#include <coreinit/cache.h>
+#include <coreinit/debug.h>
+#include <coreinit/memorymap.h>
+#include <coreinit/thread.h>
+#include <coreinit/time.h>
+
+#include "CrashDump.hpp"
+#include "Debug/CrashDump.hpp"
+
+namespace Library::Debug
+{
+    void CrashDump::Enable(CrashDumpSink function, void* context)
+    {
+        sinkContext = context;
+        sink.store(function);
+    }
+
+    void CrashDump::Disable()
+    {
+        sink.store(nullptr);
+    }
+
+    bool CrashDump::AddRange(uint32_t address, uint32_t length)
+    {
+        uint32_t count = rangeCount.load();
+        if (count >= MAX_RANGES) return false;
+        ranges[count] = { address, length };
+        rangeCount.store(count + 1);
+        return true;
+    }
+
+    void CrashDump::ClearRanges()
+    {
+        rangeCount.store(0);
+    }
+
+    bool CrashDump::IsReadable(uint32_t address, uint32_t length)
+    {
+        if (length == 0) return true;
+        if (address + length < address) return false;
+        for (uint32_t page = address & ~0xFFFu; page < address + length; page += 0x1000)
+        {
+            if (!OSIsAddressValid(page)) return false;
+        }
+        return true;
+    }
+
+    bool CrashDump::PutBytes(const void* data, uint32_t length)
+    {
+        if (truncated || BUFFER_SIZE - size < length)
+        {
+            truncated = true;
+            return false;
+        }
+        std::memcpy(buffer + size, data, length);
+        size += length;
+        return true;
+    }
+
+    bool CrashDump::Put32(uint32_t value)
+    {
+        uint8_t bytes[4] = { static_cast<uint8_t>(value >> 24), static_cast<uint8_t>(value >> 16), static_cast<uint8_t>(value >> 8), static_cast<uint8_t>(value) };
+        return PutBytes(bytes, sizeof(bytes));
+    }
+
+    bool CrashDump::Put64(uint64_t value)
+    {
+        return Put32(static_cast<uint32_t>(value >> 32)) && Put32(static_cast<uint32_t>(value));
+    }
+
+    uint32_t CrashDump::BeginSection(uint32_t tag)
+    {
+        uint32_t offset = size;
+        Put32(tag);
+        Put32(0);
+        return offset;
+    }
+
+    // Patches the section size; a cut section is dropped entirely
+    void CrashDump::EndSection(uint32_t offset)
+    {
+        if (truncated)
+        {
+            size = offset;
+            return;
+        }
+        uint32_t length = size - offset - 8;
+        buffer[offset + 4] = static_cast<uint8_t>(length >> 24);
+        buffer[offset + 5] = static_cast<uint8_t>(length >> 16);
+        buffer[offset + 6] = static_cast<uint8_t>(length >> 8);
+        buffer[offset + 7] = static_cast<uint8_t>(length);
+    }
+
+    void CrashDump::WriteContext(OSContext* context)
+    {
+        uint32_t section = BeginSection(TAG_CONTEXT);
+        for (uint32_t i = 0; i < 32; i++) Put32(context->gpr[i]);
+        for (uint32_t i = 0; i < 32; i++)
+        {
+            uint64_t bits;
+            std::memcpy(&bits, &context->fpr[i], sizeof(bits));
+            Put64(bits);
+        }
+        Put32(context->cr);
+        Put32(context->lr);
+        Put32(context->ctr);
+        Put32(context->xer);
+        Put32(context->srr0);
+        Put32(context->srr1);
+        Put32(context->dsisr);
+        Put32(context->dar);
+        Put64(context->fpscr);
+        EndSection(section);
+    }
+
+    void CrashDump::WriteStack(OSContext* context)
+    {
+        uint32_t section = BeginSection(TAG_STACK);
+        uint32_t countOffset = size;
+        Put32(0);
+
+        uint32_t count = 0;
+        uint32_t sp = context->gpr[1];
+        while (count < MAX_FRAMES && sp != 0 && (sp & 3) == 0 && IsReadable(sp, 4))
+        {
+            uint32_t next = *reinterpret_cast<const uint32_t*>(sp);
+            if (next <= sp || (next & 3) != 0 || !IsReadable(next, 8)) break;
+
+            uint32_t lr = *reinterpret_cast<const uint32_t*>(next + 4);
+            if (!Put32(next) || !Put32(lr)) break;
+            count++;
+            sp = next;
+        }
+
+        if (!truncated)
+        {
+            uint8_t bytes[4] = { static_cast<uint8_t>(count >> 24), static_cast<uint8_t>(count >> 16), static_cast<uint8_t>(count >> 8), static_cast<uint8_t>(count) };
+            std::memcpy(buffer + countOffset, bytes, sizeof(bytes));
+        }
+        EndSection(section);
+    }
+
+    void CrashDump::WriteThreads()
+    {
+        uint32_t section = BeginSection(TAG_THREADS);
+        uint32_t countOffset = size;
+        Put32(0);
+
+        OSThread* it = OSGetCurrentThread();
+        uint32_t guard = 0;
+        while (it && guard++ < MAX_THREADS && IsReadable(reinterpret_cast<uint32_t>(it), sizeof(OSThread)) && it->link.prev)
+        {
+            it = it->link.prev;
+        }
+
+        uint32_t count = 0;
+        for (OSThread* cur = it; cur && count < MAX_THREADS; cur = cur->link.next)
+        {
+            if (!IsReadable(reinterpret_cast<uint32_t>(cur), sizeof(OSThread))) break;
+
+            char name[THREAD_NAME_SIZE] = {};
+            uint32_t address = reinterpret_cast<uint32_t>(cur->name);
+            if (cur->name && IsReadable(address, 1))
+            {
+                for (uint32_t i = 0; i < THREAD_NAME_SIZE - 1; i++)
+                {
+                    if (((address + i) & 0xFFF) == 0 && !IsReadable(address + i, 1)) break;
+                    name[i] = cur->name[i];
+                    if (name[i] == '\0') break;
+                }
+            }
+
+            uint8_t idState[4] = { static_cast<uint8_t>(cur->id >> 8), static_cast<uint8_t>(cur->id), cur->state, 0 };
+            if (!Put32(reinterpret_cast<uint32_t>(cur)) || !PutBytes(idState, sizeof(idState)) ||
+                !Put32(static_cast<uint32_t>(cur->priority)) || !PutBytes(name, sizeof(name))) break;
+            count++;
+        }
+
+        if (!truncated)
+        {
+            uint8_t bytes[4] = { static_cast<uint8_t>(count >> 24), static_cast<uint8_t>(count >> 16), static_cast<uint8_t>(count >> 8), static_cast<uint8_t>(count) };
+            std::memcpy(buffer + countOffset, bytes, sizeof(bytes));
+        }
+        EndSection(section);
+    }
+
+    void CrashDump::WriteMemory()
+    {
+        uint32_t count = rangeCount.load();
+        for (uint32_t i = 0; i < count && !truncated; i++)
+        {
+            const Range& range = ranges[i];
+            if (!IsReadable(range.address, range.size)) continue;
+
+            // a range larger than what is left is cut to fit, which ends the dump
+            uint32_t available = BUFFER_SIZE - size;
+            if (available <= 16)
+            {
+                truncated = true;
+                break;
+            }
+            uint32_t length = range.size;
+            if (length > available - 16) length = (available - 16) & ~3u;
+
+            uint32_t section = BeginSection(TAG_MEMORY);
+            Put32(range.address);
+            Put32(length);
+            PutBytes(reinterpret_cast<const void*>(range.address), length);
+            static constexpr const uint8_t PADDING[4] = {};
+            PutBytes(PADDING, (4 - (length & 3)) & 3);
+            EndSection(section);
+            if (length < range.size) truncated = true;
+        }
+    }
+
+    bool CrashDump::Write(OSExceptionType type, OSContext* context, uint32_t core)
+    {
+        if (!sink.load() || !context) return false;
+        if (writing.test_and_set()) return false; // only the first crashing core dumps
+
+        size = 0;
+        truncated = false;
+
+        Put32(('L' << 24) | ('D' << 16) | ('C' << 8) | 'D');
+        Put32(static_cast<uint32_t>(VERSION) << 16);
+        Put32(0);
+        Put32(static_cast<uint32_t>(type));
+        Put32(core);
+        Put64(static_cast<uint64_t>(OSGetTime()));
+        Put32(0);
+
+        WriteContext(context);
+        WriteStack(context);
+        WriteThreads();
+        WriteMemory();
+
+        uint32_t flags = truncated ? FLAG_TRUNCATED : 0;
+        buffer[6] = static_cast<uint8_t>(flags >> 8);
+        buffer[7] = static_cast<uint8_t>(flags);
+        buffer[8] = static_cast<uint8_t>(size >> 24);
+        buffer[9] = static_cast<uint8_t>(size >> 16);
+        buffer[10] = static_cast<uint8_t>(size >> 8);
+        buffer[11] = static_cast<uint8_t>(size);
+
+        DCFlushRange(buffer, size);
+        return true;
+    }
+
+    // The crashed thread continues at Persist on a stack of its own, so the
+    // sink runs in thread context where I/O may block and take locks.
+    void CrashDump::Resume(OSContext* context, const char* message)
+    {
+        uint32_t stack = (reinterpret_cast<uint32_t>(persistStack) + PERSIST_STACK_SIZE - 0x10) & ~0xFu;
+        *reinterpret_cast<uint32_t*>(stack) = 0; // end of the back chain
+
+        context->srr0 = reinterpret_cast<uint32_t>(&Persist);
+        context->lr = 0;
+        context->gpr[1] = stack;
+        context->gpr[3] = reinterpret_cast<uint32_t>(message);
+    }
+
+    void CrashDump::Persist(const char* message)
+    {
+        CrashDumpSink function = sink.load();
+        if (function) function(buffer, size, sinkContext);
+        OSFatal(message);
+    }
+}
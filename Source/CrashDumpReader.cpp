@@ -0,0 +1,206 @@
+#include <cstdint>
+#include <cstring>
+
+#include <fcntl.h>
+#include <unistd.h>
+
+#include "Debug/CrashDump.hpp"
+
+namespace Library::Debug
+{
+    class DumpCursor
+    {
+    public:
+        DumpCursor(const uint8_t* data, uint32_t size) : _data(data), _size(size), _offset(0) {}
+
+        bool Get32(uint32_t& value)
+        {
+            if (_size - _offset < 4) return false;
+            const uint8_t* p = _data + _offset;
+            value = (static_cast<uint32_t>(p[0]) << 24) | (static_cast<uint32_t>(p[1]) << 16) | (static_cast<uint32_t>(p[2]) << 8) | p[3];
+            _offset += 4;
+            return true;
+        }
+
+        bool Get64(uint64_t& value)
+        {
+            uint32_t high, low;
+            if (!Get32(high) || !Get32(low)) return false;
+            value = (static_cast<uint64_t>(high) << 32) | low;
+            return true;
+        }
+
+        bool GetBytes(void* out, uint32_t size)
+        {
+            if (_size - _offset < size) return false;
+            std::memcpy(out, _data + _offset, size);
+            _offset += size;
+            return true;
+        }
+
+        bool Skip(uint32_t size)
+        {
+            if (_size - _offset < size) return false;
+            _offset += size;
+            return true;
+        }
+
+        uint32_t Remaining() const
+        {
+            return _size - _offset;
+        }
+
+    private:
+        const uint8_t* _data;
+        uint32_t _size;
+        uint32_t _offset;
+    };
+
+    static bool ReadContext(DumpCursor& cursor, CrashContext& context)
+    {
+        for (uint32_t i = 0; i < 32; i++)
+        {
+            if (!cursor.Get32(context.gpr[i])) return false;
+        }
+        for (uint32_t i = 0; i < 32; i++)
+        {
+            uint64_t bits;
+            if (!cursor.Get64(bits)) return false;
+            std::memcpy(&context.fpr[i], &bits, sizeof(bits));
+        }
+        return cursor.Get32(context.cr) && cursor.Get32(context.lr) && cursor.Get32(context.ctr) && cursor.Get32(context.xer) &&
+               cursor.Get32(context.srr0) && cursor.Get32(context.srr1) && cursor.Get32(context.dsisr) && cursor.Get32(context.dar) &&
+               cursor.Get64(context.fpscr);
+    }
+
+    bool ReadCrashDump(const uint8_t* data, uint32_t size, CrashDumpData& out)
+    {
+        DumpCursor cursor(data, size);
+
+        uint32_t magic, version, total, reserved;
+        if (!cursor.Get32(magic) || magic != (('L' << 24) | ('D' << 16) | ('C' << 8) | 'D')) return false;
+        if (!cursor.Get32(version) || (version >> 16) != 1) return false;
+        if (!cursor.Get32(total) || total > size) return false;
+        if (!cursor.Get32(out.type) || !cursor.Get32(out.core) || !cursor.Get64(out.time) || !cursor.Get32(reserved)) return false;
+
+        out.truncated = (version & 1) != 0;
+        out.context = {};
+        out.stack.clear();
+        out.threads.clear();
+        out.memory.clear();
+
+        DumpCursor body(data, total);
+        body.Skip(32);
+        while (body.Remaining() >= 8)
+        {
+            uint32_t tag, length;
+            if (!body.Get32(tag) || !body.Get32(length) || body.Remaining() < length) return false;
+
+            DumpCursor section(data + (total - body.Remaining()), length);
+            body.Skip(length);
+
+            switch (tag)
+            {
+                case 1:
+                {
+                    if (!ReadContext(section, out.context)) return false;
+                    break;
+                }
+                case 2:
+                {
+                    uint32_t count;
+                    if (!section.Get32(count)) return false;
+                    for (uint32_t i = 0; i < count; i++)
+                    {
+                        CrashFrame frame;
+                        if (!section.Get32(frame.sp) || !section.Get32(frame.lr)) return false;
+                        out.stack.push_back(frame);
+                    }
+                    break;
+                }
+                case 3:
+                {
+                    uint32_t count;
+                    if (!section.Get32(count)) return false;
+                    for (uint32_t i = 0; i < count; i++)
+                    {
+                        CrashThread thread;
+                        uint32_t idState, priority;
+                        char name[32];
+                        if (!section.Get32(thread.address) || !section.Get32(idState) || !section.Get32(priority) || !section.GetBytes(name, sizeof(name))) return false;
+                        thread.id = static_cast<uint16_t>(idState >> 16);
+                        thread.state = static_cast<uint8_t>(idState >> 8);
+                        thread.priority = static_cast<int32_t>(priority);
+                        thread.name.assign(name, strnlen(name, sizeof(name)));
+                        out.threads.push_back(std::move(thread));
+                    }
+                    break;
+                }
+                case 4:
+                {
+                    CrashMemory memory;
+                    uint32_t length;
+                    if (!section.Get32(memory.address) || !section.Get32(length)) return false;
+                    if (section.Remaining() < length) return false;
+                    memory.data.resize(length);
+                    if (!section.GetBytes(memory.data.data(), length)) return false;
+                    out.memory.push_back(std::move(memory));
+                    break;
+                }
+                default: break; // unknown sections are skipped
+            }
+        }
+
+        return true;
+    }
+
+    bool OpenCrashDumpFile(CrashDumpFile& file, const char* path)
+    {
+        file.fd = -1;
+        if (!path) return false;
+
+        int fd = open(path, O_WRONLY | O_CREAT | O_TRUNC, 0644);
+        if (fd < 0) return false;
+
+        static constexpr const uint8_t ZERO[0x1000] = {};
+        for (uint32_t written = 0; written < CRASH_DUMP_MAX_SIZE; written += sizeof(ZERO))
+        {
+            if (write(fd, ZERO, sizeof(ZERO)) != static_cast<ssize_t>(sizeof(ZERO)))
+            {
+                close(fd);
+                return false;
+            }
+        }
+        if (fsync(fd) != 0)
+        {
+            close(fd);
+            return false;
+        }
+
+        file.fd = fd;
+        return true;
+    }
+
+    void CloseCrashDumpFile(CrashDumpFile& file)
+    {
+        if (file.fd < 0) return;
+        close(file.fd);
+        file.fd = -1;
+    }
+
+    void CrashDumpFileSink(const uint8_t* data, uint32_t size, void* context)
+    {
+        const CrashDumpFile* file = static_cast<const CrashDumpFile*>(context);
+        if (!file || file->fd < 0) return;
+
+        if (lseek(file->fd, 0, SEEK_SET) != 0) return;
+        uint32_t written = 0;
+        while (written < size)
+        {
+            ssize_t result = write(file->fd, data + written, size - written);
+            if (result <= 0) return;
+            written += static_cast<uint32_t>(result);
+        }
+        fsync(file->fd);
+    }
+}
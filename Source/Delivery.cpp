@@ -0,0 +1,110 @@
+#include <algorithm>
+#include <cstdint>
+
+#include <coreinit/thread.h>
+#include <coreinit/time.h>
+
+#include "Delivery.hpp"
+#include "Breakpoint.hpp"
+#include "Debug/Delivery.hpp"
+
+namespace Library::Debug
+{
+    bool Delivery::Start(const DeliveryConfig& value)
+    {
+        if (running.exchange(true)) return false;
+
+        config = value;
+        config.batch = std::clamp<uint32_t>(config.batch, 1, MAX_BATCH);
+        config.minSleep = std::max<uint32_t>(config.minSleep, 1);
+        config.maxSleep = std::max(config.maxSleep, config.minSleep);
+
+        OSCreateThread
+        (
+            &thread,
+            Worker,
+            0,
+            nullptr,
+            stack + STACK_SIZE,
+            STACK_SIZE,
+            config.priority,
+            config.affinity
+        );
+        OSSetThreadName(&thread, "Delivery");
+        OSResumeThread(&thread);
+        return true;
+    }
+
+    void Delivery::Stop()
+    {
+        if (!running.exchange(false)) return;
+        OSJoinThread(&thread, nullptr);
+    }
+
+    void Delivery::SetDataCallback(BreakInfoCallback callback, void* context)
+    {
+        mutex.lock();
+        dataCallback = { callback, context };
+        mutex.unlock();
+        Quiesce();
+    }
+
+    void Delivery::SetInstructionCallback(BreakInfoCallback callback, void* context)
+    {
+        mutex.lock();
+        instructionCallback = { callback, context };
+        mutex.unlock();
+        Quiesce();
+    }
+
+    // Waits until the worker is idle or has finished the pass that may still
+    // hold the previous callback. From inside a callback there is nothing to
+    // wait for: the old one returns right after.
+    void Delivery::Quiesce()
+    {
+        if (OSGetCurrentThread() == &thread) return;
+
+        uint32_t pass = passes.load();
+        while (delivering.load() && passes.load() == pass)
+        {
+            OSSleepTicks(OSMicrosecondsToTicks(config.minSleep));
+        }
+    }
+
+    // Without a callback the buffer is left alone so polling keeps working.
+    uint32_t Delivery::Deliver(const Callback& callback, uint32_t (*drain)(RegisterInfo*, uint32_t))
+    {
+        if (!callback.function) return 0;
+
+        uint32_t count = drain(batch, config.batch);
+        if (count != 0) callback.function(batch, count, callback.context);
+        return count;
+    }
+
+    // Delivers at most one batch per buffer per pass, then sleeps minSleep, so
+    // a flood cannot pin the core; the sleep doubles while idle. The first
+    // event of a burst after an idle period can wait up to maxSleep. There is
+    // no wakeup, the exception side never signals, so maxSleep bounds the
+    // latency.
+    int Delivery::Worker(int, const char**)
+    {
+        uint32_t sleep = config.minSleep;
+        while (running.load())
+        {
+            delivering.store(true);
+            mutex.lock();
+            Callback data = dataCallback;
+            Callback instruction = instructionCallback;
+            mutex.unlock();
+
+            uint32_t delivered = Deliver(data, BreakpointManager::DrainDataBreakInfo) +
+                                 Deliver(instruction, BreakpointManager::DrainInstructionBreakInfo);
+            passes.fetch_add(1);
+            delivering.store(false);
+
+            sleep = delivered ? config.minSleep : std::min(sleep * 2, config.maxSleep);
+            OSSleepTicks(OSMicrosecondsToTicks(sleep));
+        }
+        return 0;
+    }
+}
@@ -0,0 +1,239 @@
+#include <bit>
+#include <cstdint>
+#include <cstring>
+
+#include "Debug/EventStream.hpp"
+
+namespace Library::Debug
+{
+    static constexpr const uint8_t MAGIC[4] = { 'L', 'D', 'E', 'S' };
+
+    static constexpr const uint8_t FIELD_GPR = 1 << 0;
+    static constexpr const uint8_t FIELD_FPR = 1 << 1;
+    static constexpr const uint8_t FIELD_PC = 1 << 2;
+    static constexpr const uint8_t FIELD_DAR = 1 << 3;
+    static constexpr const uint8_t FIELD_CR = 1 << 4;
+    static constexpr const uint8_t FIELD_LR = 1 << 5;
+    static constexpr const uint8_t FIELD_CTR = 1 << 6;
+
+    static uint8_t* PutVarint(uint8_t* out, uint32_t value)
+    {
+        while (value >= 0x80)
+        {
+            *out++ = static_cast<uint8_t>(value | 0x80);
+            value >>= 7;
+        }
+        *out++ = static_cast<uint8_t>(value);
+        return out;
+    }
+
+    static uint8_t* PutDelta(uint8_t* out, uint32_t current, uint32_t previous)
+    {
+        int32_t delta = static_cast<int32_t>(current - previous);
+        uint32_t zigzag = (static_cast<uint32_t>(delta) << 1) ^ static_cast<uint32_t>(delta >> 31);
+        return PutVarint(out, zigzag);
+    }
+
+    static bool GetVarint(const uint8_t*& p, const uint8_t* end, uint32_t& value)
+    {
+        value = 0;
+        for (uint32_t shift = 0; shift < 35; shift += 7)
+        {
+            if (p >= end) return false;
+            uint8_t b = *p++;
+            value |= static_cast<uint32_t>(b & 0x7F) << shift;
+            if ((b & 0x80) == 0) return true;
+        }
+        return false;
+    }
+
+    static bool GetDelta(const uint8_t*& p, const uint8_t* end, uint32_t& value)
+    {
+        uint32_t zigzag;
+        if (!GetVarint(p, end, zigzag)) return false;
+        value += (zigzag >> 1) ^ (0u - (zigzag & 1));
+        return true;
+    }
+
+    EventWriter::EventWriter(uint8_t* buffer, uint32_t capacity) : _buffer(buffer), _capacity(capacity), _size(0)
+    {
+        if (_capacity < HEADER_SIZE) return;
+        std::memcpy(_buffer, MAGIC, sizeof(MAGIC));
+        _buffer[4] = VERSION;
+        _buffer[5] = 0;
+        _size = HEADER_SIZE;
+    }
+
+    void EventWriter::Reset(uint8_t* buffer, uint32_t capacity)
+    {
+        _buffer = buffer;
+        _capacity = capacity;
+        _size = 0;
+    }
+
+    uint32_t EventWriter::Size() const
+    {
+        return _size;
+    }
+
+    bool EventWriter::Write(uint8_t channel, const RegisterInfo& info)
+    {
+        if (channel >= CHANNEL_COUNT) return false;
+
+        uint32_t space = _capacity - _size;
+        if (space >= MAX_FRAME_SIZE)
+        {
+            _size += Encode(_buffer + _size, channel, info);
+            return true;
+        }
+
+        // Near the end of the buffer the frame is staged so a record that does
+        // not fit leaves both the buffer and the channel state untouched.
+        uint8_t frame[MAX_FRAME_SIZE];
+        RegisterInfo previous = _previous[channel];
+        uint32_t size = Encode(frame, channel, info);
+        if (size > space)
+        {
+            _previous[channel] = previous;
+            return false;
+        }
+        std::memcpy(_buffer + _size, frame, size);
+        _size += size;
+        return true;
+    }
+
+    uint32_t EventWriter::Encode(uint8_t* out, uint8_t channel, const RegisterInfo& info)
+    {
+        RegisterInfo& previous = _previous[channel];
+
+        uint32_t gprMask = 0;
+        uint32_t fprMask = 0;
+        for (uint32_t i = 0; i < 32; i++)
+        {
+            if (info.gpr[i] != previous.gpr[i]) gprMask |= 1u << i;
+            if (std::memcmp(&info.fpr[i], &previous.fpr[i], sizeof(double)) != 0) fprMask |= 1u << i;
+        }
+
+        uint8_t fields = 0;
+        if (gprMask) fields |= FIELD_GPR;
+        if (fprMask) fields |= FIELD_FPR;
+        if (info.pc != previous.pc) fields |= FIELD_PC;
+        if (info.dar != previous.dar) fields |= FIELD_DAR;
+        if (info.cr != previous.cr) fields |= FIELD_CR;
+        if (info.lr != previous.lr) fields |= FIELD_LR;
+        if (info.ctr != previous.ctr) fields |= FIELD_CTR;
+
+        uint8_t* p = out + 3;
+        *p++ = fields;
+        if (fields & FIELD_GPR) p = PutVarint(p, gprMask);
+        if (fields & FIELD_FPR) p = PutVarint(p, fprMask);
+        if (fields & FIELD_PC) p = PutDelta(p, info.pc, previous.pc);
+        if (fields & FIELD_DAR) p = PutDelta(p, info.dar, previous.dar);
+        if (fields & FIELD_CR) p = PutDelta(p, info.cr, previous.cr);
+        if (fields & FIELD_LR) p = PutDelta(p, info.lr, previous.lr);
+        if (fields & FIELD_CTR) p = PutDelta(p, info.ctr, previous.ctr);
+
+        for (uint32_t mask = gprMask; mask; mask &= mask - 1)
+        {
+            uint32_t i = std::countr_zero(mask);
+            p = PutDelta(p, info.gpr[i], previous.gpr[i]);
+        }
+
+        for (uint32_t mask = fprMask; mask; mask &= mask - 1)
+        {
+            uint32_t i = std::countr_zero(mask);
+            uint64_t bits;
+            std::memcpy(&bits, &info.fpr[i], sizeof(bits));
+            for (int32_t shift = 56; shift >= 0; shift -= 8) *p++ = static_cast<uint8_t>(bits >> shift);
+        }
+
+        uint32_t length = (p - out) - 3;
+        out[0] = static_cast<uint8_t>(length >> 8);
+        out[1] = static_cast<uint8_t>(length);
+        out[2] = channel;
+
+        previous = info;
+        return p - out;
+    }
+
+    EventReader::EventReader(const uint8_t* data, uint32_t size) : _data(data), _size(size), _offset(0), _failed(false)
+    {
+        if (_size < EventWriter::HEADER_SIZE || std::memcmp(_data, MAGIC, sizeof(MAGIC)) != 0 || _data[4] != EventWriter::VERSION)
+        {
+            _failed = true;
+            return;
+        }
+        _offset = EventWriter::HEADER_SIZE;
+    }
+
+    void EventReader::Reset(const uint8_t* data, uint32_t size)
+    {
+        _data = data;
+        _size = size;
+        _offset = 0;
+    }
+
+    bool EventReader::Failed() const
+    {
+        return _failed;
+    }
+
+    bool EventReader::Next(EventRecord& record)
+    {
+        if (_failed || _size - _offset < 3) return false;
+
+        const uint8_t* frame = _data + _offset;
+        uint32_t length = (static_cast<uint32_t>(frame[0]) << 8) | frame[1];
+        uint8_t channel = frame[2];
+        if (channel >= EventWriter::CHANNEL_COUNT || _size - _offset - 3 < length || length == 0)
+        {
+            _failed = true;
+            return false;
+        }
+
+        const uint8_t* p = frame + 3;
+        const uint8_t* end = p + length;
+        RegisterInfo info = _previous[channel];
+
+        uint8_t fields = *p++;
+        uint32_t gprMask = 0;
+        uint32_t fprMask = 0;
+        bool ok = true;
+        if (fields & FIELD_GPR) ok = ok && GetVarint(p, end, gprMask);
+        if (fields & FIELD_FPR) ok = ok && GetVarint(p, end, fprMask);
+        if (fields & FIELD_PC) ok = ok && GetDelta(p, end, info.pc);
+        if (fields & FIELD_DAR) ok = ok && GetDelta(p, end, info.dar);
+        if (fields & FIELD_CR) ok = ok && GetDelta(p, end, info.cr);
+        if (fields & FIELD_LR) ok = ok && GetDelta(p, end, info.lr);
+        if (fields & FIELD_CTR) ok = ok && GetDelta(p, end, info.ctr);
+
+        for (uint32_t mask = gprMask; ok && mask; mask &= mask - 1)
+        {
+            ok = GetDelta(p, end, info.gpr[std::countr_zero(mask)]);
+        }
+
+        for (uint32_t mask = fprMask; ok && mask; mask &= mask - 1)
+        {
+            if (end - p < 8)
+            {
+                ok = false;
+                break;
+            }
+            uint64_t bits = 0;
+            for (uint32_t i = 0; i < 8; i++) bits = (bits << 8) | *p++;
+            std::memcpy(&info.fpr[std::countr_zero(mask)], &bits, sizeof(bits));
+        }
+
+        if (!ok || p != end)
+        {
+            _failed = true;
+            return false;
+        }
+
+        _previous[channel] = info;
+        _offset += 3 + length;
+        record.channel = channel;
+        record.info = info;
+        return true;
+    }
+}
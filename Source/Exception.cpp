@@ -4,6 +4,11 @@
 #include <coreinit/thread.h>
 #include <coreinit/exception.h>
 #include <coreinit/core.h>
+#include <coreinit/interrupts.h>
+
+#include "Exception.hpp"
+#include "CrashDump.hpp"
+#include "Debug/Log.hpp"
 
 namespace Library::Debug::Exception
 {
@@ -51,8 +56,17 @@ namespace Library::Debug::Exception
     static OSThread sThread[3];
     static Callback sCallback[3];
     static ChainInfo sChain[3];
-    // 明示的に初期化しておく（静的領域でもゼロ初期化されるが明示的な方が確実で読みやすい）
-    static std::atomic<bool> sInHandler[3] = { false, false, false };
+
+    // ネスト用：深さごとにハンドラ用スタックとコンテキストを分ける
+    // 登録スタック (sStack) は切り替えまでの数命令だけ使うので、ネストした例外が先頭から使い直しても壊れない
+    static constexpr const uint32_t MAX_DEPTH = 4;
+    static constexpr const uint32_t HANDLER_STACK_SIZE = 0x1000;
+    alignas(16) static uint8_t sHandlerStack[3][MAX_DEPTH][HANDLER_STACK_SIZE];
+    static OSContext sHandlerContext[3][MAX_DEPTH];
+    static std::atomic<uint32_t> sDepth[3];
+    static std::atomic<uint32_t> sMaxDepth[3];
+    static std::atomic<uint32_t> sNested[3];
+    static std::atomic<uint32_t> sDropped[3];
 
     OSExceptionCallbackFn GetCallback(OSExceptionType type, uint32_t core)
     {
@@ -125,44 +139,80 @@ namespace Library::Debug::Exception
         }
     }
 
+    // この階層を返して context へ戻る。戻らない
+    // 返した直後から読み込みまでに割り込みが入ると、同じ階層のスタックとコンテキストを
+    // 使用中のまま再利用されるので、割り込みを止めてから返す。止めた状態は読み込み時に
+    // srr1 から元に戻る
+    [[noreturn]] static void Leave(std::atomic<uint32_t>& depth, OSContext* context)
+    {
+        OSDisableInterrupts();
+        depth.fetch_sub(1, std::memory_order_release);
+        __OSSetAndLoadContext(context);
+        __builtin_unreachable();
+    }
+
+    // ハンドラ用スタック上で動く本体。戻らない（Leave か OSFatal で抜ける）
+    void Dispatch(uint32_t value, OSContext * interruptedContext, uint32_t core)
+    {
+        OSExceptionType type = static_cast<OSExceptionType>(value);
+        std::atomic<uint32_t>& depth = sDepth[core];
+
+        auto callback = GetCallback(type, core);
+        if (callback)
+        {
+            if (callback(interruptedContext) == TRUE)
+            {
+                // 成功時：深さを戻して元のコンテキストへ戻す
+                Leave(depth, interruptedContext);
+            }
+            // callback が FALSE を返した場合は下で致命処理へ
+        }
+
+        // 失敗/未ハンドル時：ダンプを残してから致命
+        // ダンプがあればスレッド文脈に戻して sink に渡し、そこで OSFatal する
+        if (CrashDump::Write(type, interruptedContext, core))
+        {
+            CrashDump::Resume(interruptedContext, GetString(type));
+            Leave(depth, interruptedContext);
+        }
+        OSFatal(GetString(type)); // 戻らないので階層は返さない
+    }
+
     void Handler(OSExceptionType type, OSContext * interruptedContext, OSContext * callbackContext)
     {
         // 1) core をまず安全に決める（interruptedContext->upir が信頼できる前提だが範囲チェック）
         uint32_t core = interruptedContext ? interruptedContext->upir : OSGetCoreId();
         if (core >= 3) core = OSGetCoreId(); // フォールバック（安全策）
 
-        std::atomic<bool>& in = sInHandler[core];
-
-        // 2) 再入検出：取れなければ即抜け（**スピン禁止**）
-        bool expected = false;
-        if (!in.compare_exchange_strong(expected, true,
-                                         std::memory_order_acquire,
-                                         std::memory_order_relaxed))
+        // 2) 深さを確保。同コアでしかネストしないので、上の階層は下が戻るまで進まない
+        uint32_t level = sDepth[core].fetch_add(1, std::memory_order_acquire);
+        if (level >= MAX_DEPTH)
         {
-            // 既に同コアで処理中 → 例外ハンドラ内でスピンは危険なので即戻る
-            // ここでは何もしないで戻る。必要なら統計/ログフラグだけ立てる（ただしログも慎重に）
+            // 上限：これ以上は積めないので従来通り何もせず戻る（スピン禁止）
+            sDepth[core].fetch_sub(1, std::memory_order_release);
+            sDropped[core].fetch_add(1, std::memory_order_relaxed);
+            Log("Exception: %s dropped at depth %u on core %u at 0x%08x", GetString(type), level, core, interruptedContext ? interruptedContext->srr0 : 0);
             return;
         }
+        if (level > 0) sNested[core].fetch_add(1, std::memory_order_relaxed);
 
-        // 3) 実処理：可能な限り最小に。フラグはコンテキスト切替より前にクリアする必要がある。
-        __OSSetCurrentUserContext(callbackContext);
+        uint32_t max = sMaxDepth[core].load(std::memory_order_relaxed);
+        if (level + 1 > max) sMaxDepth[core].store(level + 1, std::memory_order_relaxed);
 
-        auto callback = GetCallback(type, core);
-        if (callback)
-        {
-            if (callback(interruptedContext) == TRUE)
-            {
-                // 成功時：フラグをクリアして元のコンテキストへ戻す
-                in.store(false, std::memory_order_release);
-                __OSSetAndLoadContext(interruptedContext); // たぶん戻らない
-                return; // 防御的に書く（たいていここには戻らない）
-            }
-            // callback が FALSE を返した場合は下で致命処理へ（フラグはクリアしておく）
-        }
+        // 3) この階層専用のコンテキストを現在のユーザーコンテキストにする。
+        // ここでネストした例外が起きると、カーネルはこの階層の状態をここに保存し、
+        // それが次の階層の interruptedContext になる
+        OSContext& context = sHandlerContext[core][level];
+        context = *callbackContext;
+        __OSSetCurrentUserContext(&context);
 
-        // 失敗/未ハンドル時：フラグをクリアして致命
-        in.store(false, std::memory_order_release);
-        OSFatal(GetString(type));
+        ExceptionSwitchStack(type, interruptedContext, core, sHandlerStack[core][level] + HANDLER_STACK_SIZE, Dispatch);
+    }
+
+    ExceptionNesting GetNesting(uint32_t core)
+    {
+        if (core >= 3) return {};
+        return { sDepth[core].load(), sMaxDepth[core].load(), sNested[core].load(), sDropped[core].load() };
     }
 
     void SetExceptionHandler()
@@ -0,0 +1,12 @@
+# void ExceptionSwitchStack(uint32_t type, OSContext* interrupted, uint32_t core, void* stack, void (*function)(uint32_t, OSContext*, uint32_t))
+# Continues the exception on a per-depth handler stack. function never
+# returns: it leaves through __OSSetAndLoadContext or OSFatal.
+.global ExceptionSwitchStack
+ExceptionSwitchStack:
+    clrrwi r6, r6, 4
+    li r0, 0
+    stwu r0, -0x10(r6)
+    mr r1, r6
+    mtctr r7
+    bctrl
+    trap
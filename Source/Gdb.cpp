@@ -0,0 +1,443 @@
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "Debug/Gdb.hpp"
+
+namespace Library::Debug
+{
+    static constexpr const char HEX[] = "0123456789abcdef";
+
+    static int32_t FromHexDigit(char c)
+    {
+        if ('0' <= c && c <= '9') return c - '0';
+        if ('a' <= c && c <= 'f') return c - 'a' + 10;
+        if ('A' <= c && c <= 'F') return c - 'A' + 10;
+        return -1;
+    }
+
+    // Parses a hex number and advances the view past it
+    static uint32_t ParseHex(std::string_view& text)
+    {
+        uint32_t value = 0;
+        while (!text.empty() && FromHexDigit(text.front()) >= 0)
+        {
+            value = (value << 4) | FromHexDigit(text.front());
+            text.remove_prefix(1);
+        }
+        return value;
+    }
+
+    static bool Skip(std::string_view& text, char c)
+    {
+        if (text.empty() || text.front() != c) return false;
+        text.remove_prefix(1);
+        return true;
+    }
+
+    static void AppendHex(std::string& out, uint64_t value, uint32_t bytes)
+    {
+        for (int32_t i = bytes - 1; i >= 0; i--)
+        {
+            uint8_t b = static_cast<uint8_t>(value >> (i * 8));
+            out.push_back(HEX[b >> 4]);
+            out.push_back(HEX[b & 0xF]);
+        }
+    }
+
+    static void AppendHexBytes(std::string& out, const uint8_t* data, uint32_t size)
+    {
+        for (uint32_t i = 0; i < size; i++) AppendHex(out, data[i], 1);
+    }
+
+    static void AppendBinary(std::string& out, const uint8_t* data, uint32_t size)
+    {
+        for (uint32_t i = 0; i < size; i++)
+        {
+            char c = static_cast<char>(data[i]);
+            if (c == '$' || c == '#' || c == '}' || c == '*')
+            {
+                out.push_back('}');
+                c ^= 0x20;
+            }
+            out.push_back(c);
+        }
+    }
+
+    GdbServer::GdbServer(GdbTransport& transport, GdbTarget& target) : _transport(transport), _target(target) {}
+
+    bool GdbServer::Poll()
+    {
+        // Parsed as it arrives so _input never holds more than one packet
+        char buffer[0x1000];
+        while (_connected)
+        {
+            uint32_t space = std::min<uint32_t>(sizeof(buffer), PACKET_SIZE - _input.size());
+            int32_t read = _transport.Read(buffer, space);
+            if (read < 0) _connected = false;
+            if (read <= 0) break;
+            _input.append(buffer, read);
+            Parse();
+        }
+
+        GdbStop stop;
+        if (_connected && _running && _target.PollStop(stop))
+        {
+            _running = false;
+            _stop = stop;
+            SendStop(stop);
+        }
+
+        Flush();
+        return _connected;
+    }
+
+    void GdbServer::Parse()
+    {
+        while (!_input.empty() && _connected)
+        {
+            if (_discarding)
+            {
+                size_t hash = _input.find('#');
+                if (hash == std::string::npos || hash + 3 > _input.size())
+                {
+                    _input.erase(0, std::min(hash, _input.size()));
+                    return;
+                }
+                _input.erase(0, hash + 3);
+                _discarding = false;
+                continue;
+            }
+
+            char c = _input.front();
+            if (c == '$')
+            {
+                size_t hash = _input.find('#');
+                if (hash == std::string::npos || hash + 3 > _input.size())
+                {
+                    // larger than the advertised PacketSize, dropped up to its checksum
+                    if (_input.size() < PACKET_SIZE) return;
+                    _input.clear();
+                    _discarding = true;
+                    if (!_noAck) _output.push_back('-');
+                    return;
+                }
+
+                uint8_t sum = 0;
+                for (size_t i = 1; i < hash; i++) sum += static_cast<uint8_t>(_input[i]);
+                int32_t high = FromHexDigit(_input[hash + 1]);
+                int32_t low = FromHexDigit(_input[hash + 2]);
+                bool valid = high >= 0 && low >= 0 && sum == ((high << 4) | low);
+
+                // unescape in place: '}' is only used as an escape by the client
+                std::string packet;
+                packet.reserve(hash - 1);
+                for (size_t i = 1; i < hash; i++)
+                {
+                    if (_input[i] == '}' && i + 1 < hash) packet.push_back(_input[++i] ^ 0x20);
+                    else packet.push_back(_input[i]);
+                }
+                _input.erase(0, hash + 3);
+
+                if (!_noAck) _output.push_back(valid ? '+' : '-');
+                if (valid) HandlePacket(packet);
+            }
+            else if (c == 0x03)
+            {
+                _input.erase(0, 1);
+                if (_running)
+                {
+                    _running = false;
+                    SendStop(_stop);
+                }
+            }
+            else if (c == '-' && !_noAck)
+            {
+                _input.erase(0, 1);
+                _output += _lastPacket;
+            }
+            else
+            {
+                _input.erase(0, 1); // '+' and line noise
+            }
+        }
+    }
+
+    void GdbServer::HandlePacket(std::string_view packet)
+    {
+        if (packet.empty()) return SendPacket("");
+
+        char command = packet.front();
+        std::string_view args = packet.substr(1);
+
+        switch (command)
+        {
+            case '?': return SendStop(_stop);
+            case 'g':
+            {
+                std::string out;
+                out.reserve(REGISTER_COUNT * 16);
+                for (uint32_t i = 0; i < REGISTER_COUNT; i++) out += Register(i);
+                return SendPacket(out);
+            }
+            case 'p':
+            {
+                uint32_t number = ParseHex(args);
+                if (number >= REGISTER_COUNT) return SendPacket("E00");
+                return SendPacket(Register(number));
+            }
+            case 'm': return HandleReadMemory(args, false);
+            case 'x': return HandleReadMemory(args, true);
+            case 'M': return HandleWriteMemory(args, false);
+            case 'X': return HandleWriteMemory(args, true);
+            case 'Z': return HandleBreakpoint(args, true);
+            case 'z': return HandleBreakpoint(args, false);
+            case 'c':
+            case 's':
+                // single step is not available without halting, so both resume until the next hit
+                _running = true;
+                return;
+            case 'H': return SendPacket("OK");
+            case 'T': return SendPacket("OK");
+            case 'q':
+            case 'Q':
+                return HandleQuery(packet);
+            case 'D':
+                SendPacket("OK");
+                _connected = false;
+                return;
+            case 'k':
+                _connected = false;
+                return;
+            default: return SendPacket("");
+        }
+    }
+
+    void GdbServer::HandleQuery(std::string_view packet)
+    {
+        if (packet.starts_with("qSupported"))
+        {
+            std::string out = "PacketSize=";
+            AppendHex(out, PACKET_SIZE, 2);
+            out += ";QStartNoAckMode+;qXfer:threads:read+;binary-upload+;hwbreak+";
+            return SendPacket(out);
+        }
+        if (packet == "QStartNoAckMode")
+        {
+            SendPacket("OK");
+            _noAck = true;
+            return;
+        }
+        if (packet.starts_with("qXfer:threads:read:"))
+        {
+            return HandleThreads(packet.substr(std::strlen("qXfer:threads:read:")));
+        }
+        if (packet == "qfThreadInfo")
+        {
+            std::string out = "m";
+            for (const GdbThread& thread : _target.Threads())
+            {
+                if (out.size() > 1) out.push_back(',');
+                AppendHex(out, thread.id + 1, 4);
+            }
+            return SendPacket(out.size() > 1 ? out : "l");
+        }
+        if (packet == "qsThreadInfo") return SendPacket("l");
+        if (packet == "qAttached") return SendPacket("1");
+        SendPacket("");
+    }
+
+    // Thread ids are reported offset by one since GDB reserves id 0
+    void GdbServer::HandleThreads(std::string_view annex)
+    {
+        Skip(annex, ':');
+        uint32_t offset = ParseHex(annex);
+        Skip(annex, ',');
+        uint32_t length = std::min(ParseHex(annex), PACKET_SIZE / 2);
+
+        if (offset == 0)
+        {
+            _threadsXml = "<?xml version=\"1.0\"?>\n<threads>\n";
+            for (const GdbThread& thread : _target.Threads())
+            {
+                std::string id;
+                AppendHex(id, thread.id + 1, 4);
+                _threadsXml += "<thread id=\"" + id + "\" name=\"";
+                for (char c : thread.name)
+                {
+                    switch (c)
+                    {
+                        case '<': _threadsXml += "&lt;"; break;
+                        case '>': _threadsXml += "&gt;"; break;
+                        case '&': _threadsXml += "&amp;"; break;
+                        case '"': _threadsXml += "&quot;"; break;
+                        default: _threadsXml.push_back(c); break;
+                    }
+                }
+                _threadsXml += "\"/>\n";
+            }
+            _threadsXml += "</threads>\n";
+        }
+
+        if (offset >= _threadsXml.size()) return SendPacket("l");
+
+        uint32_t size = std::min<uint32_t>(length, _threadsXml.size() - offset);
+        std::string out(1, offset + size < _threadsXml.size() ? 'm' : 'l');
+        AppendBinary(out, reinterpret_cast<const uint8_t*>(_threadsXml.data() + offset), size);
+        SendPacket(out);
+    }
+
+    void GdbServer::HandleBreakpoint(std::string_view args, bool insert)
+    {
+        uint32_t type = ParseHex(args);
+        if (!Skip(args, ',') || type > 4) return SendPacket("");
+        uint32_t address = ParseHex(args);
+        if (!Skip(args, ',')) return SendPacket("E01");
+        uint32_t length = ParseHex(args);
+
+        auto kind = static_cast<GdbBreakpointType>(type);
+        bool result = insert ? _target.InsertBreakpoint(kind, address, length) : _target.RemoveBreakpoint(kind, address, length);
+        SendPacket(result ? "OK" : "E01");
+    }
+
+    void GdbServer::HandleReadMemory(std::string_view args, bool binary)
+    {
+        uint32_t address = ParseHex(args);
+        if (!Skip(args, ',')) return SendPacket("E01");
+        uint32_t length = ParseHex(args);
+
+        // worst case a binary reply doubles in size when every byte is escaped
+        length = std::min(length, PACKET_SIZE / 2 - 1);
+        if (length == 0) return SendPacket(binary ? "b" : "");
+
+        std::vector<uint8_t> data(length);
+        uint32_t read = _target.ReadMemory(address, data.data(), length);
+        if (read == 0) return SendPacket("E14");
+
+        std::string out;
+        if (binary)
+        {
+            out.reserve(read + 1);
+            out.push_back('b');
+            AppendBinary(out, data.data(), read);
+        }
+        else
+        {
+            out.reserve(read * 2);
+            AppendHexBytes(out, data.data(), read);
+        }
+        SendPacket(out);
+    }
+
+    void GdbServer::HandleWriteMemory(std::string_view args, bool binary)
+    {
+        uint32_t address = ParseHex(args);
+        if (!Skip(args, ',')) return SendPacket("E01");
+        uint32_t length = ParseHex(args);
+        if (!Skip(args, ':')) return SendPacket("E01");
+        if (length == 0) return SendPacket("OK");
+
+        std::vector<uint8_t> data;
+        if (binary)
+        {
+            if (args.size() < length) return SendPacket("E01");
+            data.assign(args.begin(), args.begin() + length);
+        }
+        else
+        {
+            if (args.size() < length * 2) return SendPacket("E01");
+            data.resize(length);
+            for (uint32_t i = 0; i < length; i++)
+            {
+                int32_t high = FromHexDigit(args[i * 2]);
+                int32_t low = FromHexDigit(args[i * 2 + 1]);
+                if (high < 0 || low < 0) return SendPacket("E01");
+                data[i] = static_cast<uint8_t>((high << 4) | low);
+            }
+        }
+
+        uint32_t written = _target.WriteMemory(address, data.data(), length);
+        SendPacket(written == length ? "OK" : "E14");
+    }
+
+    // PowerPC register numbering: r0-r31, f0-f31, pc, msr, cr, lr, ctr, xer, fpscr
+    std::string GdbServer::Register(uint32_t number) const
+    {
+        const RegisterInfo& info = _stop.info;
+        std::string out;
+
+        if (number < 32)
+        {
+            AppendHex(out, info.gpr[number], 4);
+        }
+        else if (number < 64)
+        {
+            uint64_t bits;
+            std::memcpy(&bits, &info.fpr[number - 32], sizeof(bits));
+            AppendHex(out, bits, 8);
+        }
+        else
+        {
+            switch (number)
+            {
+                case 64: AppendHex(out, info.pc, 4); break;
+                case 66: AppendHex(out, info.cr, 4); break;
+                case 67: AppendHex(out, info.lr, 4); break;
+                case 68: AppendHex(out, info.ctr, 4); break;
+                default: out = "xxxxxxxx"; break; // msr, xer and fpscr are not recorded
+            }
+        }
+
+        return out;
+    }
+
+    void GdbServer::SendStop(const GdbStop& stop)
+    {
+        std::string out = "T05";
+
+        static constexpr const uint32_t EXPEDITED[] = { 1, 64, 67 };
+        for (uint32_t number : EXPEDITED)
+        {
+            AppendHex(out, number, 1);
+            out.push_back(':');
+            out += Register(number);
+            out.push_back(';');
+        }
+
+        switch (stop.type)
+        {
+            case GdbBreakpointType::Write: out += "watch:"; AppendHex(out, stop.info.dar, 4); out.push_back(';'); break;
+            case GdbBreakpointType::Read: out += "rwatch:"; AppendHex(out, stop.info.dar, 4); out.push_back(';'); break;
+            case GdbBreakpointType::Access: out += "awatch:"; AppendHex(out, stop.info.dar, 4); out.push_back(';'); break;
+            default: out += "hwbreak:;"; break;
+        }
+
+        SendPacket(out);
+    }
+
+    void GdbServer::SendPacket(std::string_view payload)
+    {
+        uint8_t sum = 0;
+        for (char c : payload) sum += static_cast<uint8_t>(c);
+
+        _lastPacket.clear();
+        _lastPacket.reserve(payload.size() + 4);
+        _lastPacket.push_back('$');
+        _lastPacket.append(payload);
+        _lastPacket.push_back('#');
+        AppendHex(_lastPacket, sum, 1);
+
+        _output += _lastPacket;
+    }
+
+    // Replies produced during one poll are written with a single transport call
+    void GdbServer::Flush()
+    {
+        if (_output.empty()) return;
+        if (!_transport.Write(_output.data(), _output.size())) _connected = false;
+        _output.clear();
+    }
+}
@@ -0,0 +1,102 @@
+#include <cstdint>
+#include <vector>
+
+#include "Breakpoint.hpp"
+#include "Memory.hpp"
+#include "Debug/Gdb.hpp"
+#include "Debug/Thread.hpp"
+
+namespace Library::Debug
+{
+    uint32_t DeviceTarget::ReadMemory(uint32_t address, void* buffer, uint32_t size)
+    {
+        if (!BreakpointManager::IsInitialized()) return 0; // the DSI recovery needs the handler installed
+        return Memory::Read(address, buffer, size);
+    }
+
+    uint32_t DeviceTarget::WriteMemory(uint32_t address, const void* buffer, uint32_t size)
+    {
+        if (!BreakpointManager::IsInitialized()) return 0;
+        return Memory::Write(address, buffer, size);
+    }
+
+    // Z0 and Z1 share the single IABR, Z2-Z4 share the single DABR
+    bool DeviceTarget::InsertBreakpoint(GdbBreakpointType type, uint32_t address, uint32_t length)
+    {
+        if (!BreakpointManager::IsInitialized()) return false;
+
+        if (type == GdbBreakpointType::Software || type == GdbBreakpointType::Hardware)
+        {
+            if (_instructionAddress != 0 && _instructionAddress != address) return false;
+            BreakpointManager::SetInstructionBreakpoint(address);
+            _instructionAddress = address;
+            return true;
+        }
+
+        BreakpointSize size;
+        switch (length)
+        {
+            case 1: size = BreakpointSize::Bit8; break;
+            case 2: size = BreakpointSize::Bit16; break;
+            case 4: size = BreakpointSize::Bit32; break;
+            case 8: size = BreakpointSize::Bit64; break;
+            default: return false;
+        }
+
+        if (_dataAddress != 0 && _dataAddress != address) return false;
+        bool read = type != GdbBreakpointType::Write;
+        bool write = type != GdbBreakpointType::Read;
+        BreakpointManager::SetDataBreakpoint(address, read, write, size);
+        _dataAddress = address;
+        _dataType = type;
+        return true;
+    }
+
+    bool DeviceTarget::RemoveBreakpoint(GdbBreakpointType type, uint32_t address, uint32_t length)
+    {
+        if (!BreakpointManager::IsInitialized()) return false;
+
+        if (type == GdbBreakpointType::Software || type == GdbBreakpointType::Hardware)
+        {
+            if (_instructionAddress != address) return false;
+            BreakpointManager::UnsetInstructionBreakpoint();
+            _instructionAddress = 0;
+            return true;
+        }
+
+        if (_dataAddress != address) return false;
+        BreakpointManager::UnsetDataBreakpoint();
+        _dataAddress = 0;
+        return true;
+    }
+
+    bool DeviceTarget::PollStop(GdbStop& stop)
+    {
+        if (_pending.empty())
+        {
+            for (const RegisterInfo& info : BreakpointManager::ConsumeInstructionBreakInfo())
+            {
+                _pending.push_back({ GdbBreakpointType::Hardware, info });
+            }
+            for (const RegisterInfo& info : BreakpointManager::ConsumeDataBreakInfo())
+            {
+                _pending.push_back({ _dataType, info });
+            }
+        }
+
+        if (_pending.empty()) return false;
+        stop = _pending.front();
+        _pending.pop_front();
+        return true;
+    }
+
+    std::vector<GdbThread> DeviceTarget::Threads()
+    {
+        std::vector<GdbThread> threads;
+        for (Thread& thread : Thread::all())
+        {
+            threads.push_back({ thread.id(), thread.name() });
+        }
+        return threads;
+    }
+}
@@ -0,0 +1,55 @@
+#include <cerrno>
+#include <cstdint>
+
+#include <sys/select.h>
+#include <sys/socket.h>
+
+#include "Debug/Gdb.hpp"
+
+namespace Library::Debug
+{
+    static constexpr const uint32_t WRITE_TIMEOUT = 1000; // ms without progress before giving up
+
+    SocketTransport::SocketTransport(int socket) : _socket(socket) {}
+
+    int32_t SocketTransport::Read(void* buffer, uint32_t size)
+    {
+        int32_t result = recv(_socket, buffer, size, MSG_DONTWAIT);
+        if (result > 0) return result;
+        if (result == 0) return -1;
+        if (errno == EAGAIN || errno == EWOULDBLOCK || errno == EINTR) return 0;
+        return -1;
+    }
+
+    bool SocketTransport::Write(const void* data, uint32_t size)
+    {
+        const char* p = static_cast<const char*>(data);
+        while (size > 0)
+        {
+            int32_t result = send(_socket, p, size, 0);
+            if (result < 0)
+            {
+                if (errno == EINTR) continue;
+                if ((errno == EAGAIN || errno == EWOULDBLOCK) && WaitWritable()) continue;
+                return false;
+            }
+            p += result;
+            size -= result;
+        }
+        return true;
+    }
+
+    // The socket is non-blocking, so a full send buffer waits here instead
+    // of spinning on send.
+    bool SocketTransport::WaitWritable()
+    {
+        fd_set set;
+        FD_ZERO(&set);
+        FD_SET(_socket, &set);
+
+        timeval timeout;
+        timeout.tv_sec = WRITE_TIMEOUT / 1000;
+        timeout.tv_usec = (WRITE_TIMEOUT % 1000) * 1000;
+        return select(_socket + 1, nullptr, &set, nullptr, &timeout) > 0;
+    }
+}
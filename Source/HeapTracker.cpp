@@ -0,0 +1,248 @@
+#include <algorithm>
+#include <cstdint>
+#include <vector>
+
+#include <coreinit/memdefaultheap.h>
+#include <coreinit/mutex.h>
+#include <coreinit/thread.h>
+#include <coreinit/time.h>
+
+#include "HeapTracker.hpp"
+#include "Debug/Heap.hpp"
+
+namespace Library::Debug
+{
+    void HeapTracker::Initialize()
+    {
+        OSInitMutexEx(&mutex, "HeapTracker");
+    }
+
+    bool HeapTracker::Start()
+    {
+        if (running.exchange(true)) return false;
+
+        OSLockMutex(&mutex);
+        startTime = OSGetSystemTime();
+        OSUnlockMutex(&mutex);
+
+        OSCreateThread
+        (
+            &drainThread,
+            Drainer,
+            0,
+            nullptr,
+            drainStack + DRAIN_STACK_SIZE,
+            DRAIN_STACK_SIZE,
+            DRAIN_PRIORITY,
+            OS_THREAD_ATTRIB_AFFINITY_ANY
+        );
+        OSSetThreadName(&drainThread, "HeapTracker");
+        OSResumeThread(&drainThread);
+
+        originalAlloc = MEMAllocFromDefaultHeap;
+        originalAllocEx = MEMAllocFromDefaultHeapEx;
+        originalFree = MEMFreeToDefaultHeap;
+        MEMAllocFromDefaultHeapEx = AllocEx;
+        MEMAllocFromDefaultHeap = Alloc;
+        MEMFreeToDefaultHeap = Free;
+        return true;
+    }
+
+    // Threads already inside a hook keep using the saved originals, which
+    // stay valid after the pointers are restored.
+    void HeapTracker::Stop()
+    {
+        if (!running.load()) return;
+
+        MEMFreeToDefaultHeap = originalFree;
+        MEMAllocFromDefaultHeap = originalAlloc;
+        MEMAllocFromDefaultHeapEx = originalAllocEx;
+
+        running.store(false);
+        OSJoinThread(&drainThread, nullptr);
+        Drain();
+    }
+
+    void* HeapTracker::Alloc(uint32_t size)
+    {
+        void* block = originalAlloc(size);
+        if (block) Record(reinterpret_cast<uint32_t>(block), size, reinterpret_cast<uint32_t>(__builtin_frame_address(0)));
+        return block;
+    }
+
+    void* HeapTracker::AllocEx(uint32_t size, int32_t alignment)
+    {
+        void* block = originalAllocEx(size, alignment);
+        if (block) Record(reinterpret_cast<uint32_t>(block), size, reinterpret_cast<uint32_t>(__builtin_frame_address(0)));
+        return block;
+    }
+
+    // Recorded before the block goes back to the heap so the free always
+    // precedes any reuse of the address in timebase order.
+    void HeapTracker::Free(void* block)
+    {
+        if (block) Record(reinterpret_cast<uint32_t>(block), FREE_FLAG, reinterpret_cast<uint32_t>(__builtin_frame_address(0)));
+        originalFree(block);
+    }
+
+    // sp is the hook's own frame; the back chain is walked from there to
+    // collect the return addresses of the callers.
+    void HeapTracker::Record(uint32_t address, uint32_t size, uint32_t sp)
+    {
+        OSThread* thread = OSGetCurrentThread();
+        if (thread == &drainThread) return; // the aggregation's own allocations
+
+        Event event;
+        event.address = address;
+        event.size = size;
+        for (uint32_t i = 0; i < HEAP_STACK_DEPTH; i++)
+        {
+            uint32_t next = sp ? *reinterpret_cast<const uint32_t*>(sp) : 0;
+            if (next <= sp || next - sp > 0x10000 || (next & 3) != 0)
+            {
+                for (; i < HEAP_STACK_DEPTH; i++) event.frames[i] = 0;
+                break;
+            }
+            event.frames[i] = *reinterpret_cast<const uint32_t*>(next + 4);
+            sp = next;
+        }
+        event.time = OSGetSystemTime();
+
+        ThreadHeap* t = threads.acquire(thread);
+        if (!t || !t->events.push(event)) dropped.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    int HeapTracker::Drainer(int, const char**)
+    {
+        while (running.load())
+        {
+            Drain();
+            OSSleepTicks(OSMillisecondsToTicks(2));
+        }
+        return 0;
+    }
+
+    // Events of all threads are merged by timebase so an allocation on one
+    // thread is seen before its free on another. An orphan free is kept for
+    // one more pass, after that its allocation predates tracking.
+    void HeapTracker::Drain()
+    {
+        OSLockMutex(&mutex);
+        OSTime start = OSGetSystemTime();
+        batch.clear();
+        for (uint32_t i = 0; i < threads.size(); i++)
+        {
+            Event event;
+            while (threads[i].events.pop(event)) batch.push_back(event);
+        }
+        std::stable_sort(batch.begin(), batch.end(), [](const Event& a, const Event& b) { return a.time < b.time; });
+        for (const Event& event : batch) Consume(event);
+
+        uint32_t kept = 0;
+        for (uint32_t i = 0; i < orphanCount; i++)
+        {
+            if (orphans[i].time >= lastDrain) orphans[kept++] = orphans[i];
+        }
+        orphanCount = kept;
+        lastDrain = start;
+        OSUnlockMutex(&mutex);
+    }
+
+    // mutex must be held
+    void HeapTracker::Consume(const Event& event)
+    {
+        if (event.size & FREE_FLAG)
+        {
+            auto it = live.find(event.address);
+            if (it == live.end())
+            {
+                // The matching allocation may still be sitting in another
+                // thread's ring; it is settled when that event arrives. The
+                // table is fixed so it never allocates through the hooked heap.
+                if (orphanCount < MAX_ORPHANS) orphans[orphanCount++] = { event.address, event.time };
+                else dropped.fetch_add(1, std::memory_order_relaxed);
+                return;
+            }
+
+            Site& site = sites[it->second.stack];
+            site.frees++;
+            site.liveCount--;
+            site.liveBytes -= it->second.size;
+            live.erase(it);
+            return;
+        }
+
+        uint32_t stack = 2166136261u;
+        for (uint32_t frame : event.frames) stack = (stack ^ frame) * 16777619u;
+
+        Site& site = sites[stack];
+        if (site.allocations == 0) std::copy(std::begin(event.frames), std::end(event.frames), site.frames);
+        site.allocations++;
+        site.allocatedBytes += event.size;
+
+        for (uint32_t i = 0; i < orphanCount; i++)
+        {
+            if (orphans[i].address != event.address || orphans[i].time < event.time) continue;
+            orphans[i] = orphans[--orphanCount];
+            site.frees++;
+            return;
+        }
+
+        site.liveCount++;
+        site.liveBytes += event.size;
+        live[event.address] = { event.size, stack, event.time };
+    }
+
+    HeapReport HeapTracker::Collect(uint32_t minLeakAge)
+    {
+        Drain();
+
+        HeapReport report{};
+
+        OSLockMutex(&mutex);
+        OSTime now = OSGetSystemTime();
+        uint64_t elapsed = OSTicksToMicroseconds(now - startTime);
+
+        for (const auto& [stack, site] : sites)
+        {
+            HeapSite out;
+            out.stack = stack;
+            std::copy(std::begin(site.frames), std::end(site.frames), out.frames);
+            out.allocations = site.allocations;
+            out.frees = site.frees;
+            out.allocatedBytes = site.allocatedBytes;
+            out.liveCount = site.liveCount;
+            out.liveBytes = site.liveBytes;
+            out.rate = elapsed ? site.allocations * 1000000.0 / elapsed : 0.0;
+            report.sites.push_back(out);
+
+            report.liveBytes += site.liveBytes;
+            report.liveCount += site.liveCount;
+        }
+
+        OSTime threshold = OSMicrosecondsToTicks(minLeakAge);
+        for (const auto& [address, block] : live)
+        {
+            if (now - block.time < threshold) continue;
+            report.leaks.push_back({ address, block.size, block.stack, OSTicksToMicroseconds(now - block.time) });
+        }
+        report.dropped = dropped.load();
+        OSUnlockMutex(&mutex);
+
+        std::sort(report.sites.begin(), report.sites.end(), [](const HeapSite& a, const HeapSite& b) { return a.allocations > b.allocations; });
+        std::sort(report.leaks.begin(), report.leaks.end(), [](const HeapLeak& a, const HeapLeak& b) { return a.age > b.age; });
+        return report;
+    }
+
+    void HeapTracker::Reset()
+    {
+        OSLockMutex(&mutex);
+        for (uint32_t i = 0; i < threads.size(); i++) threads[i].events.clear();
+        sites.clear();
+        live.clear();
+        orphanCount = 0;
+        dropped.store(0);
+        startTime = OSGetSystemTime();
+        OSUnlockMutex(&mutex);
+    }
+}
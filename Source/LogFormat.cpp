@@ -0,0 +1,96 @@
+#include <algorithm>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <string>
+
+#include "Debug/Log.hpp"
+
+namespace Library::Debug
+{
+    // Walks the format and hands each conversion to snprintf together with
+    // its stored argument, cast back to the type the specifier expects.
+    std::string FormatLogRecord(const LogRecord& record, const char* format, bool strings)
+    {
+        std::string out;
+        if (!format) return out;
+
+        uint32_t index = 0;
+        const char* p = format;
+        while (*p)
+        {
+            if (*p != '%')
+            {
+                out.push_back(*p++);
+                continue;
+            }
+            if (p[1] == '%')
+            {
+                out.push_back('%');
+                p += 2;
+                continue;
+            }
+
+            const char* begin = p++;
+            while (*p && std::strchr("-+ #0123456789.", *p)) p++;
+            while (*p && std::strchr("hlLjzt", *p)) p++;
+            if (!*p) break;
+
+            char conversion = *p++;
+            std::string spec(begin, p);
+            if (index >= record.count)
+            {
+                out += spec;
+                continue;
+            }
+
+            uint64_t value = record.args[index];
+            LogArgType type = static_cast<LogArgType>((record.types >> (index * 2)) & 3);
+            index++;
+
+            char buffer[128];
+            int length = 0;
+            if (std::strchr("eEfFgGaA", conversion))
+            {
+                double d;
+                std::memcpy(&d, &value, sizeof(d));
+                length = std::snprintf(buffer, sizeof(buffer), spec.c_str(), d);
+            }
+            else if (conversion == 's' && strings)
+            {
+                const char* text = reinterpret_cast<const char*>(static_cast<uintptr_t>(value));
+                length = std::snprintf(buffer, sizeof(buffer), spec.c_str(), text ? text : "(null)");
+            }
+            else if (conversion == 's')
+            {
+                length = std::snprintf(buffer, sizeof(buffer), "<0x%08x>", static_cast<uint32_t>(value));
+            }
+            else if (conversion == 'p')
+            {
+                length = std::snprintf(buffer, sizeof(buffer), "0x%08x", static_cast<uint32_t>(value));
+            }
+            else if (std::strchr("diouxXc", conversion))
+            {
+                // the length modifiers are replaced to match what was stored
+                std::string base = spec.substr(0, std::min(spec.find_first_of("hlLjzt"), spec.size() - 1));
+                if (type == LogArgType::Long)
+                {
+                    length = std::snprintf(buffer, sizeof(buffer), (base + "ll" + conversion).c_str(), static_cast<unsigned long long>(value));
+                }
+                else
+                {
+                    length = std::snprintf(buffer, sizeof(buffer), (base + conversion).c_str(), static_cast<uint32_t>(value));
+                }
+            }
+            else
+            {
+                out += spec;
+                continue;
+            }
+
+            if (length > 0) out.append(buffer, std::min<uint32_t>(length, sizeof(buffer) - 1));
+        }
+
+        return out;
+    }
+}
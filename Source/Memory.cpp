@@ -0,0 +1,77 @@
+#include <algorithm>
+#include <cstdint>
+
+#include <coreinit/cache.h>
+#include <coreinit/memorymap.h>
+#include <kernel/kernel.h>
+
+#include "Memory.hpp"
+
+namespace Library::Debug
+{
+    uint32_t Memory::Read(uint32_t address, void* buffer, uint32_t size)
+    {
+        return MemoryCopy(buffer, reinterpret_cast<const void*>(address), size);
+    }
+
+    uint32_t Memory::Write(uint32_t address, const void* buffer, uint32_t size)
+    {
+        if (IsCodeAddress(address)) return WriteCode(address, buffer, size);
+        return MemoryCopy(reinterpret_cast<void*>(address), buffer, size);
+    }
+
+    // A single store of the given width for data, safe in exception context
+    bool Memory::Store(uint32_t address, uint32_t value, uint32_t size)
+    {
+        if (IsCodeAddress(address) || (address & (size - 1)) != 0) return false;
+        return MemoryStore(address, value, size) == size;
+    }
+
+    // Text is mapped read-only in user mode, so code is patched through its
+    // physical address one page-bounded chunk at a time.
+    uint32_t Memory::WriteCode(uint32_t address, const void* buffer, uint32_t size)
+    {
+        uint32_t source = reinterpret_cast<uint32_t>(buffer);
+        uint32_t written = 0;
+
+        while (written < size)
+        {
+            uint32_t dst = address + written;
+            uint32_t src = source + written;
+            uint32_t dstRemain = PAGE_SIZE - (dst & (PAGE_SIZE - 1));
+            uint32_t srcRemain = PAGE_SIZE - (src & (PAGE_SIZE - 1));
+            uint32_t length = std::min({ size - written, dstRemain, srcRemain });
+
+            if (!OSIsAddressValid(dst)) break;
+            uint32_t dstPhysical = OSEffectiveToPhysical(dst);
+            uint32_t srcPhysical = OSEffectiveToPhysical(src);
+            if (dstPhysical == 0 || srcPhysical == 0) break;
+
+            DCFlushRange(reinterpret_cast<void*>(src), length);
+            KernelCopyData(dstPhysical, srcPhysical, length);
+            DCFlushRange(reinterpret_cast<void*>(dst), length);
+            ICInvalidateRange(reinterpret_cast<void*>(dst), length);
+
+            written += length;
+        }
+
+        return written;
+    }
+
+    bool Memory::IsCodeAddress(uint32_t address)
+    {
+        return CODE_BEGIN <= address && address < CODE_END;
+    }
+
+    BOOL Memory::DSIHandler(OSContext* context)
+    {
+        if (!context) return FALSE;
+
+        uint32_t begin = reinterpret_cast<uint32_t>(&MemoryCopy);
+        uint32_t end = reinterpret_cast<uint32_t>(&MemoryCopyEnd);
+        if (context->srr0 < begin || end <= context->srr0) return FALSE;
+
+        context->srr0 = reinterpret_cast<uint32_t>(&MemoryCopyFault);
+        return TRUE;
+    }
+}
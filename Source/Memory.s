@@ -0,0 +1,95 @@
+# uint32_t MemoryCopy(void* dst, const void* src, uint32_t size)
+# Returns the number of bytes copied. A DSI raised between MemoryCopy and
+# MemoryCopyEnd is redirected to MemoryCopyFault, which returns the count
+# of bytes completed before the faulting block (r6).
+.global MemoryCopy
+MemoryCopy:
+    li r6, 0
+    cmpwi r5, 0
+    beq 9f
+    xor r7, r3, r4
+    andi. r7, r7, 3
+    bne 3f
+1:
+    andi. r7, r3, 3
+    beq 2f
+    lbz r8, 0(r4)
+    stb r8, 0(r3)
+    addi r3, r3, 1
+    addi r4, r4, 1
+    addi r6, r6, 1
+    addic. r5, r5, -1
+    beq 9f
+    b 1b
+2:
+    srwi. r7, r5, 5
+    beq 3f
+    mtctr r7
+    clrlwi r5, r5, 27
+4:
+    lwz r7, 0(r4)
+    lwz r8, 4(r4)
+    lwz r9, 8(r4)
+    lwz r10, 12(r4)
+    stw r7, 0(r3)
+    stw r8, 4(r3)
+    stw r9, 8(r3)
+    stw r10, 12(r3)
+    lwz r7, 16(r4)
+    lwz r8, 20(r4)
+    lwz r9, 24(r4)
+    lwz r10, 28(r4)
+    stw r7, 16(r3)
+    stw r8, 20(r3)
+    stw r9, 24(r3)
+    stw r10, 28(r3)
+    addi r3, r3, 32
+    addi r4, r4, 32
+    addi r6, r6, 32
+    bdnz 4b
+3:
+    cmpwi r5, 0
+    beq 9f
+    mtctr r5
+5:
+    lbz r8, 0(r4)
+    stb r8, 0(r3)
+    addi r3, r3, 1
+    addi r4, r4, 1
+    addi r6, r6, 1
+    bdnz 5b
+9:
+    mr r3, r6
+    blr
+
+# uint32_t MemoryStore(uint32_t address, uint32_t value, uint32_t size)
+# One store of size 1, 2 or 4 bytes, so an aligned store is never torn.
+# Returns size, or 0 when it faulted or size is invalid. Shares the fault
+# range of MemoryCopy.
+.global MemoryStore
+MemoryStore:
+    li r6, 0
+    cmpwi r5, 1
+    bne 1f
+    stb r4, 0(r3)
+    b 3f
+1:
+    cmpwi r5, 2
+    bne 2f
+    sth r4, 0(r3)
+    b 3f
+2:
+    cmpwi r5, 4
+    bne MemoryCopyFault
+    stw r4, 0(r3)
+3:
+    mr r3, r5
+    blr
+
+.global MemoryCopyFault
+MemoryCopyFault:
+    mr r3, r6
+    blr
+
+.global MemoryCopyEnd
+MemoryCopyEnd:
@@ -0,0 +1,208 @@
+#include <algorithm>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include <coreinit/dynload.h>
+
+#include "ModuleMap.hpp"
+#include "Debug/Module.hpp"
+
+namespace Library::Debug
+{
+    void ModuleMap::Initialize()
+    {
+        dirty.store(true);
+        OSDynLoad_AddNotifyCallback(Notify, nullptr);
+    }
+
+    void ModuleMap::Shutdown()
+    {
+        OSDynLoad_DelNotifyCallback(Notify, nullptr);
+    }
+
+    // Called by the loader: only mark the snapshot stale, the rebuild happens
+    // on the next lookup outside the loader's context.
+    void ModuleMap::Notify(OSDynLoad_Module, void*, OSDynLoad_NotifyReason, OSDynLoad_NotifyData*)
+    {
+        dirty.store(true);
+    }
+
+    // The loader is queried and the snapshot built without the mutex, which
+    // only guards swapping the published pointer.
+    std::shared_ptr<const ModuleMap::Snapshot> ModuleMap::Refresh()
+    {
+        if (!dirty.exchange(false))
+        {
+            mutex.lock();
+            std::shared_ptr<const Snapshot> current = snapshot;
+            mutex.unlock();
+            return current;
+        }
+
+        auto next = std::make_shared<Snapshot>();
+        int32_t count = OSDynLoad_GetNumberOfRPLs();
+        std::vector<OSDynLoad_NotifyData> infos(std::max<int32_t>(count, 0));
+        if (count > 0 && OSDynLoad_GetRPLInfo(0, count, infos.data()))
+        {
+            for (int32_t i = 0; i < count; i++)
+            {
+                const OSDynLoad_NotifyData& info = infos[i];
+                next->modules.push_back({ info.name ? info.name : "", info.textAddr, info.textSize, info.dataAddr, info.dataSize, info.readAddr, info.readSize });
+
+                if (info.textSize) next->ranges.push_back({ info.textAddr, info.textAddr + info.textSize, i, ModuleSection::Text });
+                if (info.dataSize) next->ranges.push_back({ info.dataAddr, info.dataAddr + info.dataSize, i, ModuleSection::Data });
+                if (info.readSize) next->ranges.push_back({ info.readAddr, info.readAddr + info.readSize, i, ModuleSection::Read });
+            }
+            std::sort(next->ranges.begin(), next->ranges.end(), [](const Range& a, const Range& b) { return a.begin < b.begin; });
+        }
+
+        std::shared_ptr<const Snapshot> published = std::move(next);
+        mutex.lock();
+        snapshot.swap(published);
+        std::shared_ptr<const Snapshot> current = snapshot;
+        mutex.unlock();
+        return current; // the previous snapshot is released here, unlocked
+    }
+
+    std::vector<ModuleInfo> ModuleMap::Modules()
+    {
+        return Refresh()->modules;
+    }
+
+    // hint remembers the last matching range; consecutive addresses usually
+    // fall into the same module and skip the binary search. A symbol only
+    // matches within its size and within the range holding the address.
+    void ModuleMap::ResolveOne(const Snapshot& snapshot, const std::vector<Symbol>& table, uint32_t address, ModuleLocation& location, uint32_t& hint)
+    {
+        const std::vector<Range>& ranges = snapshot.ranges;
+        location = { address, -1, ModuleSection::None, 0, -1, 0 };
+
+        const Range* range = nullptr;
+        if (hint < ranges.size() && ranges[hint].begin <= address && address < ranges[hint].end)
+        {
+            range = &ranges[hint];
+        }
+        else
+        {
+            auto it = std::upper_bound(ranges.begin(), ranges.end(), address, [](uint32_t value, const Range& r) { return value < r.begin; });
+            if (it != ranges.begin() && address < (it - 1)->end)
+            {
+                range = &*(it - 1);
+                hint = range - ranges.data();
+            }
+        }
+
+        if (range)
+        {
+            location.module = range->module;
+            location.section = range->section;
+            location.offset = address - range->begin;
+        }
+
+        auto it = std::upper_bound(table.begin(), table.end(), address, [](uint32_t value, const Symbol& s) { return value < s.address; });
+        if (it == table.begin()) return;
+
+        const Symbol& symbol = *(it - 1);
+        uint32_t distance = address - symbol.address;
+        if (symbol.size ? distance >= symbol.size : !range) return;
+        if (range && symbol.address < range->begin) return;
+
+        location.symbol = (it - 1) - table.begin();
+        location.symbolOffset = distance;
+    }
+
+    std::vector<ModuleLocation> ModuleMap::Resolve(const std::vector<uint32_t>& addresses)
+    {
+        std::vector<ModuleLocation> locations(addresses.size());
+        std::shared_ptr<const Snapshot> current = Refresh();
+
+        mutex.lock();
+        std::shared_ptr<const std::vector<Symbol>> table = symbols;
+        mutex.unlock();
+
+        uint32_t hint = ~0u;
+        for (uint32_t i = 0; i < addresses.size(); i++)
+        {
+            ResolveOne(*current, *table, addresses[i], locations[i], hint);
+        }
+        return locations;
+    }
+
+    static bool ParseHex(std::string_view text, uint32_t& value)
+    {
+        if (text.starts_with("0x") || text.starts_with("0X")) text.remove_prefix(2);
+        if (text.empty()) return false;
+
+        value = 0;
+        for (char c : text)
+        {
+            uint32_t digit;
+            if ('0' <= c && c <= '9') digit = c - '0';
+            else if ('a' <= c && c <= 'f') digit = c - 'a' + 10;
+            else if ('A' <= c && c <= 'F') digit = c - 'A' + 10;
+            else return false;
+            value = (value << 4) | digit;
+        }
+        return true;
+    }
+
+    // Accepts nm style lines: "<address> [size] [type] <name>", address and
+    // size in hex as printed by nm -S. A symbol without a size extends to the
+    // next one.
+    uint32_t ModuleMap::LoadSymbols(std::string_view map)
+    {
+        auto table = std::make_shared<std::vector<Symbol>>();
+
+        while (!map.empty())
+        {
+            size_t eol = map.find('\n');
+            std::string_view line = map.substr(0, eol);
+            map = eol == std::string_view::npos ? std::string_view{} : map.substr(eol + 1);
+
+            std::vector<std::string_view> tokens;
+            while (!line.empty())
+            {
+                size_t begin = line.find_first_not_of(" \t\r");
+                if (begin == std::string_view::npos) break;
+                line.remove_prefix(begin);
+                size_t end = line.find_first_of(" \t\r");
+                tokens.push_back(line.substr(0, end));
+                line = end == std::string_view::npos ? std::string_view{} : line.substr(end);
+            }
+            if (tokens.size() < 2) continue;
+
+            uint32_t address;
+            if (!ParseHex(tokens.front(), address)) continue;
+
+            uint32_t size = 0;
+            if (tokens.size() >= 4 && !ParseHex(tokens[1], size)) size = 0;
+
+            table->push_back({ address, size, std::string(tokens.back()) });
+        }
+
+        std::stable_sort(table->begin(), table->end(), [](const Symbol& a, const Symbol& b) { return a.address < b.address; });
+        for (size_t i = 0; i + 1 < table->size(); i++)
+        {
+            Symbol& symbol = (*table)[i];
+            if (symbol.size == 0) symbol.size = (*table)[i + 1].address - symbol.address;
+        }
+
+        uint32_t count = table->size();
+        std::shared_ptr<const std::vector<Symbol>> published = std::move(table);
+        mutex.lock();
+        symbols.swap(published);
+        mutex.unlock();
+        return count;
+    }
+
+    std::string ModuleMap::SymbolName(int32_t symbol)
+    {
+        mutex.lock();
+        std::shared_ptr<const std::vector<Symbol>> table = symbols;
+        mutex.unlock();
+        return (symbol >= 0 && static_cast<uint32_t>(symbol) < table->size()) ? (*table)[symbol].name : std::string{};
+    }
+}
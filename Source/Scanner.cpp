@@ -0,0 +1,350 @@
+#include <algorithm>
+#include <bit>
+#include <cstdint>
+#include <cstring>
+#include <vector>
+
+#include <coreinit/memorymap.h>
+
+#include "Scanner.hpp"
+#include "ScanKernel.hpp"
+#include "Debug/Scanner.hpp"
+
+namespace Library::Debug
+{
+    bool Scanner::IsOrdered(ScanCompare compare)
+    {
+        return compare == ScanCompare::Greater || compare == ScanCompare::Less ||
+               compare == ScanCompare::Increased || compare == ScanCompare::Decreased;
+    }
+
+    bool Scanner::Match(const uint8_t* current, const uint8_t* previous)
+    {
+        // Changed/Unchanged on floating point values compare bit patterns (NaN, -0.0)
+        bool bitwise = compare == ScanCompare::Changed || compare == ScanCompare::Unchanged;
+
+        switch (type)
+        {
+            case ScanType::U8: return CompareValue<uint8_t>(compare, current, previous, value);
+            case ScanType::U16: return CompareValue<uint16_t>(compare, current, previous, value);
+            case ScanType::U32: return CompareValue<uint32_t>(compare, current, previous, value);
+            case ScanType::U64: return CompareValue<uint64_t>(compare, current, previous, value);
+            case ScanType::Float: return bitwise ? CompareValue<uint32_t>(compare, current, previous, value) : CompareValue<float>(compare, current, previous, value);
+            case ScanType::Double: return bitwise ? CompareValue<uint64_t>(compare, current, previous, value) : CompareValue<double>(compare, current, previous, value);
+            case ScanType::Bytes: return CompareBytes(compare, current, previous, value, mask, width);
+            default: return false;
+        }
+    }
+
+    bool Scanner::IsReadable(uint32_t begin, uint32_t end, uint32_t& validPage)
+    {
+        uint32_t firstPage = begin & ~(PAGE_SIZE - 1);
+        uint32_t lastPage = (end - 1) & ~(PAGE_SIZE - 1);
+        for (uint32_t page = firstPage; ; page += PAGE_SIZE)
+        {
+            if (page != validPage)
+            {
+                if (!OSIsAddressValid(page)) return false;
+                validPage = page;
+            }
+            if (page == lastPage) return true;
+        }
+    }
+
+    bool Scanner::CanScanFast(const Region& region, uint32_t word)
+    {
+        if (!first || compare != ScanCompare::Equal) return false;
+        if ((region.begin & 3) != 0) return false;
+        if ((word + 1) * 32 > region.slots) return false;
+
+        switch (type)
+        {
+            case ScanType::U8: return stride == 1;
+            case ScanType::U16: return stride == 2;
+            case ScanType::U32: return stride == 4;
+            default: return false;
+        }
+    }
+
+    // Word-parallel equality kernels. Each returns the candidate bits of 32
+    // consecutive slots starting at the (word aligned) address, using the
+    // big-endian layout of the Espresso.
+    uint32_t Scanner::ScanWordFast(uint32_t address)
+    {
+        const uint32_t* p = reinterpret_cast<const uint32_t*>(address);
+        uint32_t bits = 0;
+
+        switch (type)
+        {
+            case ScanType::U8:
+            {
+                uint32_t pattern = value[0] * 0x01010101u;
+                for (uint32_t i = 0; i < 8; i++) bits |= MatchBytes(p[i], pattern) << (i * 4);
+                break;
+            }
+            case ScanType::U16:
+            {
+                uint16_t half;
+                std::memcpy(&half, value, sizeof(half));
+                uint32_t pattern = (static_cast<uint32_t>(half) << 16) | half;
+                for (uint32_t i = 0; i < 16; i++) bits |= MatchHalves(p[i], pattern) << (i * 2);
+                break;
+            }
+            case ScanType::U32:
+            {
+                uint32_t pattern;
+                std::memcpy(&pattern, value, sizeof(pattern));
+                for (uint32_t i = 0; i < 32; i++)
+                {
+                    bits |= static_cast<uint32_t>(p[i] == pattern) << i;
+                }
+                break;
+            }
+            default: break;
+        }
+
+        return bits;
+    }
+
+    uint32_t Scanner::ScanWord(Job& job, uint32_t word, uint32_t& valueIndex, uint32_t& validPage)
+    {
+        Region& region = *job.region;
+
+        uint32_t candidates = first ? ~0u : region.bitmap[word];
+        uint32_t slotBegin = word * 32;
+        uint32_t slotEnd = std::min(slotBegin + 32, region.slots);
+        if (slotEnd - slotBegin < 32) candidates &= (1u << (slotEnd - slotBegin)) - 1;
+        if (candidates == 0) return 0;
+
+        uint32_t base = region.begin + slotBegin * stride;
+        uint32_t end = region.begin + (slotEnd - 1) * stride + width;
+        if (!IsReadable(base, end, validPage))
+        {
+            if (!first) valueIndex += std::popcount(candidates);
+            return 0;
+        }
+
+        if (CanScanFast(region, word))
+        {
+            uint32_t bits = ScanWordFast(base);
+            for (uint32_t n = std::popcount(bits); n > 0; n--)
+            {
+                job.values.insert(job.values.end(), value, value + width);
+            }
+            job.count += std::popcount(bits);
+            return bits;
+        }
+
+        uint32_t bits = 0;
+        uint8_t current[MAX_PATTERN_SIZE];
+        while (candidates)
+        {
+            uint32_t bit = std::countr_zero(candidates);
+            candidates &= candidates - 1;
+
+            std::memcpy(current, reinterpret_cast<const void*>(base + bit * stride), width);
+            const uint8_t* previous = first ? nullptr : &region.values[(valueIndex++) * width];
+
+            if (Match(current, previous))
+            {
+                bits |= 1u << bit;
+                job.values.insert(job.values.end(), current, current + width);
+                job.count++;
+            }
+        }
+        return bits;
+    }
+
+    int Scanner::Worker(int argc, const char** argv)
+    {
+        for (uint32_t i = static_cast<uint32_t>(argc); i < jobs.size(); i += WORKER_COUNT)
+        {
+            Job& job = jobs[i];
+            uint32_t valueIndex = job.valueBegin;
+            uint32_t validPage = ~0u;
+
+            job.bitmap.resize(job.wordEnd - job.wordBegin);
+            for (uint32_t word = job.wordBegin; word < job.wordEnd; word++)
+            {
+                job.bitmap[word - job.wordBegin] = ScanWord(job, word, valueIndex, validPage);
+            }
+        }
+        return 0;
+    }
+
+    void Scanner::BuildJobs()
+    {
+        jobs.clear();
+        for (Region& region : regions)
+        {
+            if (!first && region.count == 0) continue;
+
+            uint32_t words = (region.slots + 31) / 32;
+            uint32_t chunk = std::max<uint32_t>((words + WORKER_COUNT - 1) / WORKER_COUNT, 1);
+
+            uint32_t valueBegin = 0;
+            for (uint32_t begin = 0; begin < words; begin += chunk)
+            {
+                uint32_t end = std::min(begin + chunk, words);
+                jobs.push_back({ &region, begin, end, valueBegin, 0, {}, {} });
+                if (!first)
+                {
+                    for (uint32_t word = begin; word < end; word++) valueBegin += std::popcount(region.bitmap[word]);
+                }
+            }
+        }
+    }
+
+    void Scanner::Dispatch()
+    {
+        workers.Run(Worker);
+    }
+
+    void Scanner::Merge()
+    {
+        for (Region& region : regions)
+        {
+            if (!first && region.count == 0) continue;
+            region.count = 0;
+            region.bitmap.assign((region.slots + 31) / 32, 0);
+            region.values.clear();
+        }
+
+        for (Job& job : jobs)
+        {
+            Region& region = *job.region;
+            std::copy(job.bitmap.begin(), job.bitmap.end(), region.bitmap.begin() + job.wordBegin);
+            region.values.insert(region.values.end(), job.values.begin(), job.values.end());
+            region.count += job.count;
+        }
+
+        for (Region& region : regions)
+        {
+            if (region.count == 0) region.bitmap.clear();
+            region.bitmap.shrink_to_fit();
+            region.values.shrink_to_fit();
+        }
+
+        jobs.clear();
+        jobs.shrink_to_fit();
+    }
+
+    uint32_t Scanner::First(const std::vector<ScanRange>& ranges, ScanType scanType, ScanCompare scanCompare, const std::vector<uint8_t>& scanValue, const std::vector<uint8_t>& scanMask, uint32_t alignment)
+    {
+        Reset();
+
+        uint32_t size;
+        switch (scanType)
+        {
+            case ScanType::U8: size = 1; break;
+            case ScanType::U16: size = 2; break;
+            case ScanType::U32: size = 4; break;
+            case ScanType::U64: size = 8; break;
+            case ScanType::Float: size = 4; break;
+            case ScanType::Double: size = 8; break;
+            case ScanType::Bytes: size = scanValue.size(); break;
+            default: return 0;
+        }
+
+        if (size == 0 || size > MAX_PATTERN_SIZE) return 0;
+        if (scanCompare != ScanCompare::Unknown && scanValue.size() != size) return 0;
+        if (scanCompare >= ScanCompare::Changed) return 0;
+        if (scanType == ScanType::Bytes && IsOrdered(scanCompare)) return 0;
+
+        type = scanType;
+        compare = scanCompare;
+        width = size;
+        stride = alignment ? alignment : (scanType == ScanType::Bytes ? 1 : size);
+        first = true;
+
+        std::memset(value, 0, sizeof(value));
+        std::memset(mask, 0xFF, sizeof(mask));
+        std::copy(scanValue.begin(), scanValue.end(), value);
+        std::copy(scanMask.begin(), scanMask.begin() + std::min<uint32_t>(scanMask.size(), size), mask);
+
+        for (const ScanRange& range : ranges)
+        {
+            uint32_t begin = (range.begin + stride - 1) / stride * stride;
+            if (range.end <= begin || range.end - begin < width) continue;
+
+            Region region{};
+            region.begin = begin;
+            region.slots = (range.end - begin - width) / stride + 1;
+            regions.push_back(std::move(region));
+        }
+
+        BuildJobs();
+        Dispatch();
+        Merge();
+        return Count();
+    }
+
+    uint32_t Scanner::Next(ScanCompare scanCompare, const std::vector<uint8_t>& scanValue)
+    {
+        if (regions.empty()) return 0;
+        if (scanCompare == ScanCompare::Unknown) return Count();
+
+        bool needsValue = scanCompare == ScanCompare::Equal || scanCompare == ScanCompare::NotEqual ||
+                          scanCompare == ScanCompare::Greater || scanCompare == ScanCompare::Less;
+        if (needsValue && scanValue.size() != width) return Count();
+        if (type == ScanType::Bytes && IsOrdered(scanCompare)) return Count(); // byte patterns have no order
+
+        compare = scanCompare;
+        first = false;
+        if (needsValue) std::copy(scanValue.begin(), scanValue.end(), value);
+
+        BuildJobs();
+        Dispatch();
+        Merge();
+        return Count();
+    }
+
+    uint32_t Scanner::Count()
+    {
+        uint32_t count = 0;
+        for (const Region& region : regions) count += region.count;
+        return count;
+    }
+
+    std::vector<uint32_t> Scanner::Results(uint32_t offset, uint32_t max)
+    {
+        std::vector<uint32_t> vector;
+
+        for (const Region& region : regions)
+        {
+            if (offset >= region.count)
+            {
+                offset -= region.count;
+                continue;
+            }
+
+            for (uint32_t word = 0; word < region.bitmap.size(); word++)
+            {
+                uint32_t bits = region.bitmap[word];
+                while (bits)
+                {
+                    uint32_t bit = std::countr_zero(bits);
+                    bits &= bits - 1;
+
+                    if (offset > 0)
+                    {
+                        offset--;
+                        continue;
+                    }
+                    if (vector.size() >= max) return vector;
+                    vector.push_back(region.begin + (word * 32 + bit) * stride);
+                }
+            }
+        }
+
+        return vector;
+    }
+
+    void Scanner::Reset()
+    {
+        regions.clear();
+        regions.shrink_to_fit();
+        jobs.clear();
+        jobs.shrink_to_fit();
+    }
+}
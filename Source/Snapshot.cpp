@@ -0,0 +1,135 @@
+#include <algorithm>
+#include <cstdint>
+#include <vector>
+
+#include <coreinit/memorymap.h>
+
+#include "Snapshot.hpp"
+#include "SnapshotKernel.hpp"
+#include "Memory.hpp"
+#include "Debug/Snapshot.hpp"
+
+namespace Library::Debug
+{
+    // blockSize must be a power of two no larger than a page, so a block is
+    // either entirely readable or not at all.
+    uint32_t Snapshot::Take(const std::vector<ScanRange>& ranges, uint32_t size)
+    {
+        Reset();
+        if (size < 64 || size > PAGE_SIZE || (size & (size - 1)) != 0) return 0;
+        blockSize = size;
+
+        uint32_t total = 0;
+        for (const ScanRange& range : ranges)
+        {
+            if (range.end <= range.begin) continue;
+            uint32_t begin = range.begin & ~(blockSize - 1);
+            uint32_t blocks = (range.end - begin + blockSize - 1) / blockSize;
+
+            regions.push_back({ begin, blocks, std::vector<uint64_t>(blocks, INVALID_HASH), std::vector<uint32_t>((blocks + 31) / 32, 0) });
+            total += blocks;
+        }
+
+        update = true;
+        BuildJobs();
+        Dispatch();
+        return total;
+    }
+
+    std::vector<SnapshotChange> Snapshot::Diff(bool capture, bool commit)
+    {
+        std::vector<SnapshotChange> changes;
+        if (regions.empty()) return changes;
+
+        update = commit;
+        Dispatch();
+
+        for (const Region& region : regions)
+        {
+            ForEachRun(region.changed, region.blocks, [&](uint32_t first, uint32_t count)
+            {
+                SnapshotChange change;
+                change.address = region.begin + first * blockSize;
+                change.size = count * blockSize;
+                if (capture)
+                {
+                    // the range may have been unmapped since the pass
+                    change.data.resize(change.size);
+                    if (Memory::Read(change.address, change.data.data(), change.size) != change.size) change.data.clear();
+                }
+                changes.push_back(std::move(change));
+            });
+        }
+
+        return changes;
+    }
+
+    void Snapshot::Reset()
+    {
+        regions.clear();
+        jobs.clear();
+    }
+
+    uint64_t Snapshot::HashBlock(uint32_t address)
+    {
+        return HashWords(reinterpret_cast<const uint32_t*>(address), blockSize / 4);
+    }
+
+    int Snapshot::Worker(int argc, const char** argv)
+    {
+        for (uint32_t i = static_cast<uint32_t>(argc); i < jobs.size(); i += WORKER_COUNT)
+        {
+            Job& job = jobs[i];
+            Region& region = *job.region;
+            uint32_t validPage = ~0u;
+            uint32_t invalidPage = ~0u;
+
+            for (uint32_t word = job.blockBegin / 32; word * 32 < job.blockEnd; word++)
+            {
+                uint32_t bits = 0;
+                uint32_t last = std::min((word + 1) * 32, job.blockEnd);
+                for (uint32_t block = word * 32; block < last; block++)
+                {
+                    uint32_t address = region.begin + block * blockSize;
+                    uint32_t page = address & ~(PAGE_SIZE - 1);
+
+                    uint64_t hash = INVALID_HASH;
+                    if (page != invalidPage)
+                    {
+                        if (page == validPage || OSIsAddressValid(page))
+                        {
+                            validPage = page;
+                            hash = HashBlock(address);
+                        }
+                        else invalidPage = page;
+                    }
+
+                    if (hash != region.hashes[block])
+                    {
+                        bits |= 1u << (block % 32);
+                        if (update) region.hashes[block] = hash;
+                    }
+                }
+                region.changed[word] = bits;
+            }
+        }
+        return 0;
+    }
+
+    void Snapshot::BuildJobs()
+    {
+        jobs.clear();
+        for (Region& region : regions)
+        {
+            for (uint32_t begin = 0; begin < region.blocks; begin += JOB_BLOCKS)
+            {
+                jobs.push_back({ &region, begin, std::min(begin + JOB_BLOCKS, region.blocks) });
+            }
+        }
+    }
+
+    void Snapshot::Dispatch()
+    {
+        workers.Run(Worker);
+    }
+}
@@ -0,0 +1,240 @@
+#include <cstdint>
+#include <vector>
+
+#include <coreinit/debug.h>
+#include <coreinit/thread.h>
+#include <coreinit/time.h>
+
+#include "Trace.hpp"
+#include "Memory.hpp"
+#include "Debug/Trace.hpp"
+
+namespace Library::Debug
+{
+    extern "C" uint32_t TraceEnter(uint32_t index, uint32_t lr, uint32_t sp)
+    {
+        return Trace::Enter(index, lr, sp);
+    }
+
+    extern "C" uint32_t TraceExit(uint32_t sp)
+    {
+        return Trace::Exit(sp);
+    }
+
+    bool Trace::MakeBranch(uint32_t from, uint32_t to, uint32_t& out)
+    {
+        int32_t offset = static_cast<int32_t>(to - from);
+        if (offset < -0x02000000 || offset >= 0x02000000) return false;
+        out = 0x48000000 | (static_cast<uint32_t>(offset) & 0x03FFFFFC);
+        return true;
+    }
+
+    // Only relative b/bl need fixing up; relative conditional branches are rejected
+    bool Trace::Relocate(uint32_t instruction, uint32_t from, uint32_t to, uint32_t& out)
+    {
+        uint32_t opcode = instruction >> 26;
+        bool absolute = (instruction & 2) != 0;
+
+        if (opcode == 16 && !absolute) return false;
+        if (opcode != 18 || absolute)
+        {
+            out = instruction;
+            return true;
+        }
+
+        int32_t offset = static_cast<int32_t>(instruction << 6) >> 6;
+        offset &= ~3;
+        uint32_t target = from + offset;
+        if (!MakeBranch(to, target, out)) return false;
+        out |= instruction & 1; // keep LK
+        return true;
+    }
+
+    bool Trace::Hook(uint32_t address)
+    {
+        if (address & 3) return false;
+
+        mutex.lock();
+
+        uint32_t count = hookCount.load();
+        uint32_t index = count;
+        for (uint32_t i = 0; i < count; i++)
+        {
+            if (hooks[i].address == address) index = i;
+        }
+
+        uint32_t pool = reinterpret_cast<uint32_t>(TracePool);
+        uint32_t slot = pool + index * SLOT_SIZE;
+        uint32_t branch;
+
+        if (index == count)
+        {
+            uint32_t original;
+            uint32_t code[4];
+            bool valid = index < MAX_HOOKS &&
+                         Memory::Read(address, &original, sizeof(original)) == sizeof(original) &&
+                         MakeBranch(address, slot, branch) &&
+                         MakeBranch(slot + 4, reinterpret_cast<uint32_t>(&TraceEntryCommon), code[1]) &&
+                         Relocate(original, address, slot + 8, code[2]) &&
+                         MakeBranch(slot + 12, address + 4, code[3]);
+            if (!valid)
+            {
+                mutex.unlock();
+                return false;
+            }
+
+            code[0] = 0x39800000 | index; // li r12, index
+            if (Memory::Write(slot, code, sizeof(code)) != sizeof(code))
+            {
+                mutex.unlock();
+                return false;
+            }
+
+            hooks[index] = { address, original };
+            hookCount.store(count + 1);
+        }
+        else if (!MakeBranch(address, slot, branch))
+        {
+            mutex.unlock();
+            return false;
+        }
+
+        bool result = Memory::Write(address, &branch, sizeof(branch)) == sizeof(branch);
+        mutex.unlock();
+        return result;
+    }
+
+    // The slot stays in the pool so threads already inside the function, or
+    // returning through TraceExitStub, are unaffected.
+    bool Trace::Unhook(uint32_t address)
+    {
+        mutex.lock();
+        uint32_t count = hookCount.load();
+        for (uint32_t i = 0; i < count; i++)
+        {
+            if (hooks[i].address != address) continue;
+            bool result = Memory::Write(address, &hooks[i].original, sizeof(uint32_t)) == sizeof(uint32_t);
+            mutex.unlock();
+            return result;
+        }
+        mutex.unlock();
+        return false;
+    }
+
+    uint32_t Trace::Enter(uint32_t index, uint32_t lr, uint32_t sp)
+    {
+        uint32_t continuation = reinterpret_cast<uint32_t>(TracePool) + index * SLOT_SIZE + 8;
+
+        ThreadTrace* t = threads.acquire(OSGetCurrentThread());
+        if (!t || t->depth >= MAX_DEPTH) return continuation | 1;
+
+        uint32_t depth = t->depth;
+        t->frames[depth] = { index, lr, sp };
+        t->depth = depth + 1;
+        if (!t->events.push({ index, depth, t->generation, OSGetSystemTime() })) dropped.fetch_add(1);
+        return continuation;
+    }
+
+    // Frames are matched by stack pointer, so frames skipped by longjmp are
+    // discarded instead of returning to the wrong caller. Without a matching
+    // frame there is no valid return address left to resume at.
+    uint32_t Trace::Exit(uint32_t sp)
+    {
+        OSTime now = OSGetSystemTime();
+
+        ThreadTrace* t = threads.acquire(OSGetCurrentThread());
+        if (!t) OSFatal("Trace: thread slot lost"); // a live thread's slot is never reclaimed
+
+        uint32_t depth = t->depth;
+        while (depth > 0 && t->frames[depth - 1].sp < sp) depth--;
+        if (depth == 0 || t->frames[depth - 1].sp != sp) OSFatal("Trace: shadow stack underflow");
+
+        depth--;
+        t->depth = depth;
+        const Frame& frame = t->frames[depth];
+        if (!t->events.push({ frame.index | EXIT_FLAG, depth, t->generation, now })) dropped.fetch_add(1);
+        return frame.lr;
+    }
+
+    // Rebuilds the call stack of one thread from its events. Depths let the
+    // stack resynchronize after events were dropped on a full buffer.
+    void Trace::Consume(uint32_t thread, const Event& event)
+    {
+        std::vector<Pending>& stack = pending[thread];
+        if (event.generation != pendingGeneration[thread])
+        {
+            stack.clear();
+            pendingGeneration[thread] = event.generation;
+        }
+
+        if ((event.index & EXIT_FLAG) == 0)
+        {
+            if (stack.size() > event.depth) stack.resize(event.depth);
+            while (stack.size() < event.depth) stack.push_back({ ~0u, event.time, 0 });
+            stack.push_back({ event.index, event.time, 0 });
+            return;
+        }
+
+        uint32_t index = event.index & ~EXIT_FLAG;
+        if (stack.size() > event.depth + 1) stack.resize(event.depth + 1);
+        if (stack.size() != event.depth + 1 || stack.back().index != index)
+        {
+            if (stack.size() > event.depth) stack.resize(event.depth);
+            return;
+        }
+
+        Pending top = stack.back();
+        stack.pop_back();
+
+        OSTime inclusive = event.time - top.time;
+        Node& node = nodes[hooks[index].address];
+        node.calls++;
+        node.inclusive += inclusive;
+        node.exclusive += inclusive - top.child;
+
+        uint32_t caller = 0;
+        if (!stack.empty())
+        {
+            stack.back().child += inclusive;
+            if (stack.back().index != ~0u) caller = hooks[stack.back().index].address;
+        }
+
+        Edge& edge = edges[{ caller, hooks[index].address }];
+        edge.calls++;
+        edge.inclusive += inclusive;
+    }
+
+    TraceGraph Trace::Collect()
+    {
+        for (uint32_t i = 0; i < threads.size(); i++)
+        {
+            Event event;
+            while (threads[i].events.pop(event)) Consume(i, event);
+        }
+
+        TraceGraph graph;
+        for (const auto& [address, node] : nodes)
+        {
+            graph.nodes.push_back({ address, node.calls, OSTicksToMicroseconds(node.inclusive), OSTicksToMicroseconds(node.exclusive) });
+        }
+        for (const auto& [key, edge] : edges)
+        {
+            graph.edges.push_back({ key.first, key.second, edge.calls, OSTicksToMicroseconds(edge.inclusive) });
+        }
+        graph.dropped = dropped.load();
+        return graph;
+    }
+
+    void Trace::Reset()
+    {
+        for (uint32_t i = 0; i < threads.size(); i++)
+        {
+            Event event;
+            while (threads[i].events.pop(event)) {}
+            pending[i].clear();
+        }
+        nodes.clear();
+        edges.clear();
+        dropped.store(0);
+    }
+}
@@ -0,0 +1,85 @@
+# Each hooked function entry branches to a 16-byte slot in TracePool:
+#   li r12, index
+#   b TraceEntryCommon
+#   <relocated first instruction>
+#   b function + 4
+# TraceEnter returns the address of the relocated instruction, with bit 0
+# set when no shadow frame could be pushed and LR must be left alone.
+.global TraceEntryCommon
+TraceEntryCommon:
+    stwu r1, -0x70(r1)
+    stw r3, 0x08(r1)
+    stw r4, 0x0C(r1)
+    stw r5, 0x10(r1)
+    stw r6, 0x14(r1)
+    stw r7, 0x18(r1)
+    stw r8, 0x1C(r1)
+    stw r9, 0x20(r1)
+    stw r10, 0x24(r1)
+    mflr r4
+    stw r4, 0x28(r1)
+    mfcr r0
+    stw r0, 0x2C(r1)
+    stfd f1, 0x30(r1)
+    stfd f2, 0x38(r1)
+    stfd f3, 0x40(r1)
+    stfd f4, 0x48(r1)
+    stfd f5, 0x50(r1)
+    stfd f6, 0x58(r1)
+    stfd f7, 0x60(r1)
+    stfd f8, 0x68(r1)
+    mr r3, r12
+    addi r5, r1, 0x70
+    bl TraceEnter
+    clrrwi r0, r3, 2
+    mtctr r0
+    andi. r0, r3, 1
+    lwz r0, 0x28(r1)
+    bne 1f
+    lis r0, TraceExitStub@h
+    ori r0, r0, TraceExitStub@l
+1:
+    mtlr r0
+    lwz r0, 0x2C(r1)
+    mtcr r0
+    lfd f1, 0x30(r1)
+    lfd f2, 0x38(r1)
+    lfd f3, 0x40(r1)
+    lfd f4, 0x48(r1)
+    lfd f5, 0x50(r1)
+    lfd f6, 0x58(r1)
+    lfd f7, 0x60(r1)
+    lfd f8, 0x68(r1)
+    lwz r3, 0x08(r1)
+    lwz r4, 0x0C(r1)
+    lwz r5, 0x10(r1)
+    lwz r6, 0x14(r1)
+    lwz r7, 0x18(r1)
+    lwz r8, 0x1C(r1)
+    lwz r9, 0x20(r1)
+    lwz r10, 0x24(r1)
+    addi r1, r1, 0x70
+    bctr
+
+# Hooked functions return here with the stack pointer they were entered
+# with; TraceExit pops the matching shadow frame and yields the original
+# return address.
+.global TraceExitStub
+TraceExitStub:
+    stwu r1, -0x20(r1)
+    stw r3, 0x08(r1)
+    stw r4, 0x0C(r1)
+    stfd f1, 0x10(r1)
+    addi r3, r1, 0x20
+    bl TraceExit
+    mtlr r3
+    lwz r3, 0x08(r1)
+    lwz r4, 0x0C(r1)
+    lfd f1, 0x10(r1)
+    addi r1, r1, 0x20
+    blr
+
+.global TracePool
+.balign 16
+TracePool:
+    .space 0x1000
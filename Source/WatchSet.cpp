@@ -0,0 +1,238 @@
+#include <cstdint>
+#include <vector>
+
+#include <coreinit/time.h>
+
+#include "WatchSet.hpp"
+#include "Debug/WatchSet.hpp"
+
+namespace Library::Debug
+{
+    bool WatchSet::Add(uint32_t address, bool read, bool write, BreakpointSize size)
+    {
+        if (size == BreakpointSize::Invalid) return false;
+
+        uint32_t mask = (1 << 0) | (1 << 1) | (1 << 2);
+        uint32_t enabled = true;
+        uint32_t r = static_cast<uint32_t>(read);
+        uint32_t w = static_cast<uint32_t>(write);
+        uint32_t value = (address & ~mask) | (enabled << 2 | w << 1 | r << 0);
+
+        mutex.lock();
+        uint32_t free = MAX_SLOTS;
+        for (uint32_t i = 0; i < MAX_SLOTS; i++)
+        {
+            if (slots[i].generation.load() == 0)
+            {
+                if (free == MAX_SLOTS) free = i;
+            }
+            else if (slots[i].address.load() == address)
+            {
+                mutex.unlock();
+                return false;
+            }
+        }
+        if (free == MAX_SLOTS)
+        {
+            mutex.unlock();
+            return false;
+        }
+
+        Slot& slot = slots[free];
+        slot.address.store(address);
+        slot.size.store(static_cast<uint32_t>(size));
+        slot.dabr.store(value);
+        slot.hits.store(0);
+        slot.lastPc.store(0);
+        slot.lastLr.store(0);
+        for (uint32_t core = 0; core < CORE_COUNT; core++)
+        {
+            exposureSequence[core].fetch_add(1, std::memory_order_acq_rel);
+            slot.exposure[core] = 0;
+            exposureSequence[core].fetch_add(1, std::memory_order_release);
+        }
+        slot.generation.store(nextGeneration++, std::memory_order_release);
+        if (nextGeneration == 0) nextGeneration = 1;
+        if (count.fetch_add(1) == 0) current.store(free);
+
+        mutex.unlock();
+        return true;
+    }
+
+    bool WatchSet::Remove(uint32_t address)
+    {
+        mutex.lock();
+        for (uint32_t i = 0; i < MAX_SLOTS; i++)
+        {
+            if (slots[i].generation.load() == 0 || slots[i].address.load() != address) continue;
+
+            slots[i].generation.store(0, std::memory_order_release);
+            while (recording.load(std::memory_order_acquire) != 0) {}
+            if (count.fetch_sub(1) > 1 && current.load() == i) Rotate(OSGetSystemTime());
+
+            mutex.unlock();
+            return true;
+        }
+        mutex.unlock();
+        return false;
+    }
+
+    void WatchSet::Clear()
+    {
+        mutex.lock();
+        for (Slot& slot : slots) slot.generation.store(0, std::memory_order_release);
+        while (recording.load(std::memory_order_acquire) != 0) {}
+        count.store(0);
+        current.store(0);
+        mutex.unlock();
+    }
+
+    void WatchSet::SetSliceTime(uint32_t microseconds)
+    {
+        mutex.lock();
+        sliceTicks = OSMicrosecondsToTicks(microseconds);
+        mutex.unlock();
+    }
+
+    // Exposure is what the cores actually had armed, charged up to their last
+    // thread switch.
+    std::vector<WatchStat> WatchSet::Stats()
+    {
+        std::vector<WatchStat> stats;
+
+        mutex.lock();
+        for (uint32_t i = 0; i < MAX_SLOTS; i++)
+        {
+            const Slot& slot = slots[i];
+            if (slot.generation.load() == 0) continue;
+
+            OSTime exposure = 0;
+            for (uint32_t core = 0; core < CORE_COUNT; core++)
+            {
+                OSTime value;
+                uint32_t sequence;
+                do
+                {
+                    sequence = exposureSequence[core].load(std::memory_order_acquire);
+                    value = slot.exposure[core];
+                } while ((sequence & 1) != 0 || exposureSequence[core].load(std::memory_order_acquire) != sequence);
+                exposure += value;
+            }
+
+            WatchStat stat;
+            stat.address = slot.address.load();
+            stat.size = slot.size.load();
+            stat.hits = slot.hits.load();
+            stat.exposure = OSTicksToMicroseconds(exposure);
+            stat.rate = stat.exposure ? stat.hits * 1000000.0 / stat.exposure : 0.0;
+            stat.lastPc = slot.lastPc.load();
+            stat.lastLr = slot.lastLr.load();
+            stats.push_back(stat);
+        }
+        mutex.unlock();
+
+        return stats;
+    }
+
+    bool WatchSet::IsActive()
+    {
+        return count.load(std::memory_order_relaxed) != 0;
+    }
+
+    // mutex must be held
+    void WatchSet::Rotate(OSTime now)
+    {
+        uint32_t index = current.load();
+        for (uint32_t i = 1; i <= MAX_SLOTS; i++)
+        {
+            uint32_t next = (index + i) % MAX_SLOTS;
+            if (slots[next].generation.load() == 0) continue;
+            current.store(next);
+            break;
+        }
+        sliceStart = now;
+    }
+
+    // Only runs on core, from its thread switch callback
+    void WatchSet::Charge(uint32_t core, OSTime now)
+    {
+        Core& state = cores[core];
+        if (state.generation != 0)
+        {
+            Slot& slot = slots[state.index];
+            if (slot.generation.load(std::memory_order_acquire) == state.generation)
+            {
+                exposureSequence[core].fetch_add(1, std::memory_order_acq_rel);
+                slot.exposure[core] += now - state.since;
+                exposureSequence[core].fetch_add(1, std::memory_order_release);
+            }
+        }
+        state.since = now;
+    }
+
+    // Runs inside the thread switch callback: never spins, a contended
+    // rotation is simply skipped until the next switch. The caller must
+    // issue SetDABR with the result so the accounting matches the core.
+    uint32_t WatchSet::Arm(uint32_t core)
+    {
+        if (core >= CORE_COUNT) return 0;
+
+        OSTime now = OSGetSystemTime();
+        if (mutex.try_lock())
+        {
+            if (count.load() != 0 && now - sliceStart >= sliceTicks) Rotate(now);
+            mutex.unlock();
+        }
+
+        Charge(core, now);
+
+        uint32_t index = current.load() % MAX_SLOTS;
+        Slot& slot = slots[index];
+        uint32_t generation = slot.generation.load(std::memory_order_acquire);
+        uint32_t dabr = slot.dabr.load();
+        if (generation == 0 || slot.generation.load(std::memory_order_acquire) != generation)
+        {
+            cores[core].generation = 0;
+            return 0;
+        }
+        cores[core] = { index, generation, now };
+        return dabr;
+    }
+
+    uint32_t WatchSet::Armed(uint32_t core)
+    {
+        if (core >= CORE_COUNT) return 0;
+        const Core& state = cores[core];
+        if (state.generation == 0) return 0;
+
+        const Slot& slot = slots[state.index];
+        uint32_t dabr = slot.dabr.load();
+        return slot.generation.load(std::memory_order_acquire) == state.generation ? dabr : 0;
+    }
+
+    // Attribution is by DAR rather than by the current slot since each core
+    // only picks up a new slot on its next thread switch. Remove waits for
+    // running Records, so a slot is never reused under one.
+    void WatchSet::Record(OSContext* context)
+    {
+        recording.fetch_add(1, std::memory_order_acq_rel);
+
+        uint32_t dar = context->dar;
+        for (uint32_t i = 0; i < MAX_SLOTS; i++)
+        {
+            Slot& slot = slots[i];
+            if (slot.generation.load(std::memory_order_acquire) == 0) continue;
+
+            uint32_t begin = slot.address.load();
+            uint32_t end = begin + slot.size.load();
+            if (dar < begin || end <= dar) continue;
+
+            slot.hits.fetch_add(1);
+            slot.lastPc.store(context->srr0);
+            slot.lastLr.store(context->lr);
+            break;
+        }
+
+        recording.fetch_sub(1, std::memory_order_release);
+    }
+}
@@ -0,0 +1,42 @@
+#include <cstdint>
+
+#include <coreinit/thread.h>
+
+#include "WorkerPool.hpp"
+
+namespace Library::Debug
+{
+    void WorkerPool::Run(OSThreadEntryPointFn worker)
+    {
+        for (uint32_t i = 0; i < WORKER_COUNT; i++)
+        {
+            OSThreadAttributes attribute;
+            switch(i)
+            {
+                case 0: attribute = OS_THREAD_ATTRIB_AFFINITY_CPU0; break;
+                case 1: attribute = OS_THREAD_ATTRIB_AFFINITY_CPU1; break;
+                case 2: attribute = OS_THREAD_ATTRIB_AFFINITY_CPU2; break;
+                default: return;
+            }
+
+            OSCreateThread
+            (
+                &_threads[i],
+                worker,
+                i,
+                nullptr,
+                _stacks[i] + STACK_SIZE,
+                STACK_SIZE,
+                PRIORITY,
+                attribute
+            );
+
+            OSResumeThread(&_threads[i]);
+        }
+
+        for (uint32_t i = 0; i < WORKER_COUNT; i++)
+        {
+            OSJoinThread(&_threads[i], nullptr);
+        }
+    }
+}
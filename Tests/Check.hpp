@@ -0,0 +1,34 @@
+#pragma once
+
+// Shared harness for the host tests: TEST registers a case, Main.cpp runs
+// every registered case and the first failing CHECK ends the process.
+#include <cstdio>
+#include <cstdlib>
+#include <vector>
+
+struct TestCase
+{
+    const char* name;
+    void (*function)();
+};
+
+inline std::vector<TestCase>& TestCases()
+{
+    static std::vector<TestCase> cases;
+    return cases;
+}
+
+#define TEST(name)                                                                   \
+    static void name();                                                              \
+    static const bool name##Registered = (TestCases().push_back({ #name, name }), true); \
+    static void name()
+
+#define CHECK(expression)                                                            \
+    do                                                                               \
+    {                                                                                \
+        if (!(expression))                                                           \
+        {                                                                            \
+            std::fprintf(stderr, "%s:%d: CHECK(%s) failed\n", __FILE__, __LINE__, #expression); \
+            std::exit(1);                                                            \
+        }                                                                            \
+    } while (0)
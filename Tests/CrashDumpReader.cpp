@@ -0,0 +1,167 @@
+// Host test: parses hand-built dumps with ReadCrashDump. Build and run with
+// `make -C Tests`.
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <vector>
+
+#include "Debug/CrashDump.hpp"
+#include "Check.hpp"
+
+using namespace Library::Debug;
+
+// Builds a dump the way CrashDump lays it out on the device, big-endian
+class DumpBuilder
+{
+public:
+    explicit DumpBuilder(uint16_t flags = 0)
+    {
+        Put32(('L' << 24) | ('D' << 16) | ('C' << 8) | 'D');
+        Put32((1u << 16) | flags);
+        Put32(0); // size, patched by Finish
+        Put32(3); // DSI
+        Put32(1);
+        Put64(0x0123456789ABCDEFull);
+        Put32(0);
+    }
+
+    void Put32(uint32_t value)
+    {
+        for (int shift = 24; shift >= 0; shift -= 8) _data.push_back(static_cast<uint8_t>(value >> shift));
+    }
+
+    void Put64(uint64_t value)
+    {
+        Put32(static_cast<uint32_t>(value >> 32));
+        Put32(static_cast<uint32_t>(value));
+    }
+
+    void PutBytes(const void* data, uint32_t size)
+    {
+        const uint8_t* bytes = static_cast<const uint8_t*>(data);
+        _data.insert(_data.end(), bytes, bytes + size);
+    }
+
+    void Begin(uint32_t tag)
+    {
+        Put32(tag);
+        _section = _data.size();
+        Put32(0);
+    }
+
+    void End()
+    {
+        Patch(_section, _data.size() - _section - 4);
+    }
+
+    std::vector<uint8_t> Finish()
+    {
+        Patch(8, _data.size());
+        return _data;
+    }
+
+private:
+    void Patch(size_t offset, uint32_t value)
+    {
+        for (int i = 0; i < 4; i++) _data[offset + i] = static_cast<uint8_t>(value >> (24 - i * 8));
+    }
+
+    std::vector<uint8_t> _data;
+    size_t _section = 0;
+};
+
+static void PutContext(DumpBuilder& dump)
+{
+    dump.Begin(1);
+    for (uint32_t i = 0; i < 32; i++) dump.Put32(0x100 + i);
+    for (uint32_t i = 0; i < 32; i++)
+    {
+        double value = i * 0.25;
+        uint64_t bits;
+        std::memcpy(&bits, &value, sizeof(bits));
+        dump.Put64(bits);
+    }
+    for (uint32_t i = 0; i < 8; i++) dump.Put32(0x200 + i); // cr lr ctr xer srr0 srr1 dsisr dar
+    dump.Put64(0xF);
+    dump.End();
+}
+
+TEST(AllSections)
+{
+    DumpBuilder dump;
+    PutContext(dump);
+
+    dump.Begin(2);
+    dump.Put32(2);
+    dump.Put32(0x1FFF0000); dump.Put32(0x02001000);
+    dump.Put32(0x1FFF0040); dump.Put32(0x02002000);
+    dump.End();
+
+    dump.Begin(3);
+    dump.Put32(1);
+    dump.Put32(0x10203040);
+    dump.Put32((7u << 16) | (2u << 8));
+    dump.Put32(16);
+    char name[32] = "render";
+    dump.PutBytes(name, sizeof(name));
+    dump.End();
+
+    dump.Begin(99); // unknown, skipped
+    dump.Put32(0xFFFFFFFF);
+    dump.End();
+
+    dump.Begin(4);
+    dump.Put32(0x10000000);
+    dump.Put32(3);
+    dump.PutBytes("abc\0", 4);
+    dump.End();
+
+    std::vector<uint8_t> data = dump.Finish();
+    data.resize(data.size() + 64); // stale bytes of a preallocated file
+
+    CrashDumpData out;
+    CHECK(ReadCrashDump(data.data(), data.size(), out));
+    CHECK(out.type == 3 && out.core == 1 && out.time == 0x0123456789ABCDEFull);
+    CHECK(!out.truncated);
+    CHECK(out.context.gpr[31] == 0x11F && out.context.fpr[4] == 1.0);
+    CHECK(out.context.lr == 0x201 && out.context.dar == 0x207 && out.context.fpscr == 0xF);
+    CHECK(out.stack.size() == 2 && out.stack[1].lr == 0x02002000);
+    CHECK(out.threads.size() == 1 && out.threads[0].id == 7 && out.threads[0].state == 2);
+    CHECK(out.threads[0].priority == 16 && out.threads[0].name == "render");
+    CHECK(out.memory.size() == 1 && out.memory[0].data == std::vector<uint8_t>({ 'a', 'b', 'c' }));
+}
+
+TEST(Truncated)
+{
+    DumpBuilder dump(1);
+    PutContext(dump);
+    std::vector<uint8_t> data = dump.Finish();
+
+    CrashDumpData out;
+    CHECK(ReadCrashDump(data.data(), data.size(), out));
+    CHECK(out.truncated);
+}
+
+TEST(Malformed)
+{
+    DumpBuilder dump;
+    PutContext(dump);
+    std::vector<uint8_t> data = dump.Finish();
+    CrashDumpData out;
+
+    std::vector<uint8_t> magic = data;
+    magic[0] = 'X';
+    CHECK(!ReadCrashDump(magic.data(), magic.size(), out));
+
+    // header size beyond the buffer
+    CHECK(!ReadCrashDump(data.data(), data.size() - 4, out));
+
+    // a memory section claiming more bytes than it holds
+    DumpBuilder memory;
+    memory.Begin(4);
+    memory.Put32(0x10000000);
+    memory.Put32(0x7FFFFFFF);
+    memory.End();
+    std::vector<uint8_t> oversized = memory.Finish();
+    CHECK(!ReadCrashDump(oversized.data(), oversized.size(), out));
+}
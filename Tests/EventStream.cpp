@@ -0,0 +1,85 @@
+// Host test: round-trips records through EventWriter/EventReader, including
+// a stream split across two buffers. Build and run with `make -C Tests`.
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <vector>
+
+#include "Debug/EventStream.hpp"
+#include "Check.hpp"
+
+using namespace Library::Debug;
+
+static RegisterInfo MakeRecord(uint32_t i)
+{
+    RegisterInfo info{};
+    info.pc = 0x02000000 + (i % 4) * 4;
+    info.dar = 0x10000000 + i * 8;
+    for (uint32_t r = 0; r < 32; r++) info.gpr[r] = r * 0x100;
+    info.gpr[3] = i;
+    info.gpr[1] = 0x1FFFF000 - (i % 2) * 0x20;
+    info.fpr[1] = i * 0.5;
+    info.lr = 0x02001000;
+    return info;
+}
+
+static bool Equal(const RegisterInfo& a, const RegisterInfo& b)
+{
+    return std::memcmp(&a, &b, sizeof(RegisterInfo)) == 0;
+}
+
+TEST(RoundTrip)
+{
+    constexpr uint32_t COUNT = 1000;
+    std::vector<uint8_t> first(8 * 1024);
+    std::vector<uint8_t> second(64 * 1024);
+
+    EventWriter writer(first.data(), first.size());
+    uint32_t split = 0;
+    for (uint32_t i = 0; i < COUNT; i++)
+    {
+        if (!writer.Write(i % 3, MakeRecord(i)))
+        {
+            CHECK(split == 0);
+            split = writer.Size();
+            writer.Reset(second.data(), second.size());
+            CHECK(writer.Write(i % 3, MakeRecord(i)));
+        }
+    }
+    CHECK(split != 0);
+    uint32_t total = split + writer.Size();
+
+    EventReader reader(first.data(), split);
+    EventRecord record;
+    uint32_t i = 0;
+    for (; reader.Next(record); i++)
+    {
+        CHECK(record.channel == i % 3);
+        CHECK(Equal(record.info, MakeRecord(i)));
+    }
+    CHECK(!reader.Failed());
+
+    reader.Reset(second.data(), writer.Size());
+    for (; reader.Next(record); i++)
+    {
+        CHECK(record.channel == i % 3);
+        CHECK(Equal(record.info, MakeRecord(i)));
+    }
+    CHECK(!reader.Failed());
+    CHECK(i == COUNT);
+
+    std::printf("EventStream: %.1f bytes per record\n", static_cast<double>(total) / COUNT);
+}
+
+// a corrupted channel byte is rejected instead of decoded
+TEST(CorruptChannel)
+{
+    std::vector<uint8_t> buffer(4 * 1024);
+    EventWriter writer(buffer.data(), buffer.size());
+    CHECK(writer.Write(0, MakeRecord(0)));
+    buffer[EventWriter::HEADER_SIZE + 2] = EventWriter::CHANNEL_COUNT;
+
+    EventReader reader(buffer.data(), writer.Size());
+    EventRecord record;
+    CHECK(!reader.Next(record) && reader.Failed());
+}
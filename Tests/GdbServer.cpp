@@ -0,0 +1,252 @@
+// Host test: drives GdbServer over a pair of non-blocking pipes against a
+// simulated target. Build and run with `make -C Tests`.
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <deque>
+#include <string>
+#include <vector>
+
+#include <fcntl.h>
+#include <unistd.h>
+
+#include "Debug/Gdb.hpp"
+#include "Check.hpp"
+
+using namespace Library::Debug;
+
+class PipeTransport : public GdbTransport
+{
+public:
+    PipeTransport(int in, int out) : _in(in), _out(out) {}
+
+    int32_t Read(void* buffer, uint32_t size) override
+    {
+        ssize_t result = read(_in, buffer, size);
+        if (result > 0) return static_cast<int32_t>(result);
+        return result == 0 ? -1 : 0;
+    }
+
+    bool Write(const void* data, uint32_t size) override
+    {
+        return write(_out, data, size) == static_cast<ssize_t>(size);
+    }
+
+private:
+    int _in;
+    int _out;
+};
+
+class SimulatedTarget : public GdbTarget
+{
+public:
+    static constexpr const uint32_t BASE = 0x10000000;
+
+    std::vector<uint8_t> memory = std::vector<uint8_t>(0x100);
+    std::deque<GdbStop> stops;
+    uint32_t breakpoint = 0;
+
+    uint32_t ReadMemory(uint32_t address, void* buffer, uint32_t size) override
+    {
+        if (address < BASE || address - BASE >= memory.size()) return 0;
+        size = std::min<uint32_t>(size, memory.size() - (address - BASE));
+        std::memcpy(buffer, memory.data() + (address - BASE), size);
+        return size;
+    }
+
+    uint32_t WriteMemory(uint32_t address, const void* buffer, uint32_t size) override
+    {
+        if (address < BASE || address - BASE >= memory.size()) return 0;
+        size = std::min<uint32_t>(size, memory.size() - (address - BASE));
+        std::memcpy(memory.data() + (address - BASE), buffer, size);
+        return size;
+    }
+
+    bool InsertBreakpoint(GdbBreakpointType, uint32_t address, uint32_t) override
+    {
+        if (breakpoint != 0) return false;
+        breakpoint = address;
+        return true;
+    }
+
+    bool RemoveBreakpoint(GdbBreakpointType, uint32_t address, uint32_t) override
+    {
+        if (breakpoint != address) return false;
+        breakpoint = 0;
+        return true;
+    }
+
+    bool PollStop(GdbStop& stop) override
+    {
+        if (stops.empty()) return false;
+        stop = stops.front();
+        stops.pop_front();
+        return true;
+    }
+
+    std::vector<GdbThread> Threads() override
+    {
+        return { { 0, "main" }, { 1, "<render>" } };
+    }
+};
+
+class Client
+{
+public:
+    Client(int in, int out, GdbServer& server) : _in(in), _out(out), _server(server) {}
+
+    void Send(const std::string& payload)
+    {
+        uint8_t sum = 0;
+        for (char c : payload) sum += static_cast<uint8_t>(c);
+        char checksum[3];
+        std::snprintf(checksum, sizeof(checksum), "%02x", sum);
+        std::string packet = "$" + payload + "#" + checksum;
+        CHECK(write(_out, packet.data(), packet.size()) == static_cast<ssize_t>(packet.size()));
+    }
+
+    // Polls the server and returns the payload of the next reply
+    std::string Receive()
+    {
+        for (uint32_t i = 0; i < 16; i++)
+        {
+            _server.Poll();
+            char buffer[0x4000];
+            ssize_t result = read(_in, buffer, sizeof(buffer));
+            if (result > 0) _input.append(buffer, result);
+
+            while (!_input.empty() && _input.front() == '+') _input.erase(0, 1);
+            size_t hash = _input.find('#');
+            if (!_input.empty() && _input.front() == '$' && hash != std::string::npos && hash + 3 <= _input.size())
+            {
+                std::string payload = _input.substr(1, hash - 1);
+                _input.erase(0, hash + 3);
+                return payload;
+            }
+        }
+        CHECK(!"no reply");
+        return {};
+    }
+
+    std::string Request(const std::string& payload)
+    {
+        Send(payload);
+        return Receive();
+    }
+
+private:
+    int _in;
+    int _out;
+    GdbServer& _server;
+    std::string _input;
+};
+
+// A connected server and client after the no-ack handshake
+struct Session
+{
+    Session() :
+        pipes(MakePipes()),
+        transport(pipes[0], pipes[3]),
+        server(transport, target),
+        client(pipes[2], pipes[1], server)
+    {
+        CHECK(client.Request("qSupported:multiprocess+").starts_with("PacketSize=4000;QStartNoAckMode+"));
+        CHECK(client.Request("QStartNoAckMode") == "OK");
+    }
+
+    ~Session()
+    {
+        for (int fd : pipes) close(fd);
+    }
+
+    // to server read/write, to client read/write
+    static std::vector<int> MakePipes()
+    {
+        int toServer[2];
+        int toClient[2];
+        CHECK(pipe2(toServer, O_NONBLOCK) == 0);
+        CHECK(pipe2(toClient, O_NONBLOCK) == 0);
+        return { toServer[0], toServer[1], toClient[0], toClient[1] };
+    }
+
+    std::vector<int> pipes;
+    PipeTransport transport;
+    SimulatedTarget target;
+    GdbServer server;
+    Client client;
+};
+
+TEST(Memory)
+{
+    Session session;
+    Client& client = session.client;
+
+    CHECK(client.Request("M10000000,4:deadbeef") == "OK");
+    CHECK(client.Request("m10000000,4") == "deadbeef");
+    CHECK(client.Request("X10000004,2:}\x03" "A") == "OK"); // '#' escaped as '}' 0x03, then a plain byte
+    CHECK(session.target.memory[4] == '#' && session.target.memory[5] == 'A');
+    CHECK(client.Request("x10000004,2") == "b}\x03" "A");
+    CHECK(client.Request("m20000000,4") == "E14");
+}
+
+// a packet over PacketSize is dropped without stalling the ones after it
+TEST(Oversized)
+{
+    Session session;
+    Client& client = session.client;
+
+    client.Send("M10000000,4:" + std::string(0x5000, '0'));
+    CHECK(client.Request("m10000000,4") == "00000000");
+    CHECK(client.Request("M10000000,4:deadbeef") == "OK");
+    CHECK(client.Request("m10000000,4") == "deadbeef");
+}
+
+TEST(Breakpoints)
+{
+    Session session;
+    Client& client = session.client;
+
+    CHECK(client.Request("Z1,10000010,4") == "OK");
+    CHECK(session.target.breakpoint == 0x10000010);
+    CHECK(client.Request("Z1,10000020,4") == "E01");
+    CHECK(client.Request("z1,10000010,4") == "OK");
+}
+
+// registers come from the stop record
+TEST(StopReply)
+{
+    Session session;
+    Client& client = session.client;
+
+    GdbStop stop{};
+    stop.type = GdbBreakpointType::Write;
+    stop.info.pc = 0x02001234;
+    stop.info.dar = 0x10000008;
+    stop.info.gpr[1] = 0x1FFFFF00;
+    stop.info.gpr[3] = 0x42;
+    stop.info.lr = 0x02005678;
+    session.target.stops.push_back(stop);
+
+    client.Send("c");
+    CHECK(client.Receive() == "T0501:1fffff00;40:02001234;43:02005678;watch:10000008;");
+    CHECK(client.Request("p3") == "00000042");
+    CHECK(client.Request("g").substr(0, 32) == "000000001fffff000000000000000042");
+}
+
+TEST(Threads)
+{
+    Session session;
+    Client& client = session.client;
+
+    CHECK(client.Request("qfThreadInfo") == "m00000001,00000002");
+    std::string xml = client.Request("qXfer:threads:read::0,1000");
+    CHECK(xml.front() == 'l');
+    CHECK(xml.find("name=\"&lt;render&gt;\"") != std::string::npos);
+}
+
+TEST(Detach)
+{
+    Session session;
+    CHECK(session.client.Request("D") == "OK");
+    CHECK(!session.server.Poll());
+}
@@ -0,0 +1,49 @@
+// Host test: formats fixed-width log records with a format table, the way a
+// host does after receiving them from the device. Build and run with
+// `make -C Tests`.
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <string>
+
+#include "Debug/Log.hpp"
+#include "Check.hpp"
+
+using namespace Library::Debug;
+
+template<typename... Args>
+static LogRecord MakeRecord(uint32_t format, Args... args)
+{
+    LogRecord record{};
+    record.format = format;
+    record.count = sizeof...(Args);
+    uint64_t values[LOG_MAX_ARGS] = { LogEncode(args)... };
+    uint32_t shift = 0;
+    ((record.types |= static_cast<uint32_t>(LogTypeOf<Args>()) << shift, shift += 2), ...);
+    for (uint32_t i = 0; i < record.count; i++) record.args[i] = values[i];
+    return record;
+}
+
+// same offsets as the 32-bit device
+TEST(Layout)
+{
+    CHECK(offsetof(LogRecord, format) == 16);
+    CHECK(offsetof(LogRecord, args) == 24);
+}
+
+TEST(Format)
+{
+    LogRecord a = MakeRecord(0x02001000, 42, -7, 0x123456789ull);
+    CHECK(FormatLogRecord(a, "%d %i %llx") == "42 -7 123456789");
+    CHECK(FormatLogRecord(a, "%5d|%-3d|%lld") == "   42|-7 |4886718345");
+
+    LogRecord b = MakeRecord(0x02001010, 1.5, 'x', 0x10000000u);
+    CHECK(FormatLogRecord(b, "%.2f %c %p") == "1.50 x 0x10000000");
+
+    // strings only exist on the device
+    LogRecord c = MakeRecord(0x02001020, static_cast<uint32_t>(0x02002000));
+    CHECK(FormatLogRecord(c, "name=%s") == "name=<0x02002000>");
+
+    CHECK(FormatLogRecord(a, "100%% %d %d %d %d") == "100% 42 -7 4886718345 %d");
+    CHECK(FormatLogRecord(a, nullptr).empty());
+}
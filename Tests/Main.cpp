@@ -0,0 +1,14 @@
+#include <cstdio>
+#include <cstring>
+
+#include "Check.hpp"
+
+int main(int, char** argv)
+{
+    const char* suite = std::strrchr(argv[0], '/');
+    suite = suite ? suite + 1 : argv[0];
+
+    for (const TestCase& test : TestCases()) test.function();
+    std::printf("%s: %zu tests ok\n", suite, TestCases().size());
+    return 0;
+}
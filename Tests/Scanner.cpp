@@ -0,0 +1,88 @@
+// Host test: the scanner's comparisons and word-parallel equality kernels,
+// checked against a plain per-byte compare. Build and run with
+// `make -C Tests`.
+#include <array>
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <random>
+
+#include "ScanKernel.hpp"
+#include "Check.hpp"
+
+using namespace Library::Debug;
+
+static uint32_t NaiveBytes(uint32_t word, uint32_t pattern)
+{
+    uint32_t bits = 0;
+    for (uint32_t n = 0; n < 4; n++)
+    {
+        uint32_t shift = 24 - n * 8;
+        if (((word >> shift) & 0xFF) == ((pattern >> shift) & 0xFF)) bits |= 1u << n;
+    }
+    return bits;
+}
+
+static uint32_t NaiveHalves(uint32_t word, uint32_t pattern)
+{
+    return static_cast<uint32_t>((word >> 16) == (pattern >> 16)) | static_cast<uint32_t>((word & 0xFFFF) == (pattern & 0xFFFF)) << 1;
+}
+
+// bytes drawn from values around the carry and borrow edges of the kernels
+TEST(WordKernels)
+{
+    static const uint8_t edges[] = { 0x00, 0x01, 0x7F, 0x80, 0x81, 0xFE, 0xFF };
+    std::mt19937 random(26);
+
+    for (uint32_t i = 0; i < 200000; i++)
+    {
+        uint32_t word = 0;
+        for (uint32_t n = 0; n < 4; n++) word = (word << 8) | edges[random() % sizeof(edges)];
+        uint8_t byte = edges[random() % sizeof(edges)];
+        uint16_t half = static_cast<uint16_t>(word >> (random() % 2 ? 16 : 0));
+        if (random() % 4 == 0) word = random();
+
+        CHECK(MatchBytes(word, byte * 0x01010101u) == NaiveBytes(word, byte * 0x01010101u));
+        uint32_t pattern = (static_cast<uint32_t>(half) << 16) | half;
+        CHECK(MatchHalves(word, pattern) == NaiveHalves(word, pattern));
+    }
+
+    CHECK(MatchBytes(0x12003412, 0x12121212) == 0b1001);
+    CHECK(MatchHalves(0xBEEF0000, 0xBEEFBEEF) == 0b01);
+}
+
+TEST(Values)
+{
+    auto bytes = [](auto value)
+    {
+        std::array<uint8_t, sizeof(value)> out;
+        std::memcpy(out.data(), &value, sizeof(value));
+        return out;
+    };
+
+    auto five = bytes(5u), seven = bytes(7u);
+    CHECK(CompareValue<uint32_t>(ScanCompare::Greater, seven.data(), nullptr, five.data()));
+    CHECK(!CompareValue<uint32_t>(ScanCompare::Less, seven.data(), nullptr, five.data()));
+    CHECK(CompareValue<uint32_t>(ScanCompare::Increased, seven.data(), five.data(), nullptr));
+    CHECK(CompareValue<uint32_t>(ScanCompare::Unchanged, five.data(), five.data(), nullptr));
+    CHECK(!CompareValue<uint32_t>(static_cast<ScanCompare>(99), five.data(), five.data(), five.data()));
+
+    // an unchanged NaN only compares equal bitwise, which is what Match uses
+    auto nan = bytes(std::nanf(""));
+    CHECK(!CompareValue<float>(ScanCompare::Unchanged, nan.data(), nan.data(), nullptr));
+    CHECK(CompareValue<uint32_t>(ScanCompare::Unchanged, nan.data(), nan.data(), nullptr));
+}
+
+TEST(Bytes)
+{
+    const uint8_t current[] = { 0xDE, 0xAD, 0xBE, 0xEF };
+    const uint8_t pattern[] = { 0xDE, 0x00, 0xBE, 0xE0 };
+    const uint8_t exact[] = { 0xFF, 0xFF, 0xFF, 0xFF };
+    const uint8_t wildcard[] = { 0xFF, 0x00, 0xFF, 0xF0 };
+
+    CHECK(!CompareBytes(ScanCompare::Equal, current, nullptr, pattern, exact, 4));
+    CHECK(CompareBytes(ScanCompare::Equal, current, nullptr, pattern, wildcard, 4));
+    CHECK(!CompareBytes(ScanCompare::NotEqual, current, nullptr, pattern, wildcard, 4));
+    CHECK(CompareBytes(ScanCompare::Changed, current, pattern, nullptr, exact, 4));
+    CHECK(!CompareBytes(ScanCompare::Greater, current, nullptr, pattern, exact, 4)); // no order on patterns
+}
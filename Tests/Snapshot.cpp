@@ -0,0 +1,54 @@
+// Host test: the snapshot's block hash and the extraction of changed runs
+// from its per-block bitmap. Build and run with `make -C Tests`.
+#include <cstdint>
+#include <random>
+#include <utility>
+#include <vector>
+
+#include "SnapshotKernel.hpp"
+#include "Check.hpp"
+
+using namespace Library::Debug;
+
+// any single word change, including to zero, changes the hash
+TEST(Hash)
+{
+    std::mt19937 random(37);
+    std::vector<uint32_t> block(0x1000 / 4);
+    for (uint32_t& word : block) word = random();
+
+    uint64_t base = HashWords(block.data(), block.size());
+    CHECK(base == HashWords(block.data(), block.size()));
+    CHECK(HashWords(block.data(), 16) != 0);
+
+    for (uint32_t i = 0; i < block.size(); i++)
+    {
+        uint32_t saved = block[i];
+        block[i] = i % 2 ? 0 : saved ^ (1u << (i % 32));
+        CHECK(HashWords(block.data(), block.size()) != base);
+        block[i] = saved;
+    }
+
+    std::vector<uint32_t> zero(0x1000 / 4, 0);
+    CHECK(HashWords(zero.data(), zero.size()) != 0);
+    CHECK(HashWords(zero.data(), 64 / 4) != HashWords(zero.data(), zero.size()));
+}
+
+TEST(Runs)
+{
+    auto runs = [](const std::vector<uint32_t>& changed, uint32_t blocks)
+    {
+        std::vector<std::pair<uint32_t, uint32_t>> out;
+        ForEachRun(changed, blocks, [&](uint32_t first, uint32_t count) { out.push_back({ first, count }); });
+        return out;
+    };
+
+    using Runs = std::vector<std::pair<uint32_t, uint32_t>>;
+    CHECK(runs({ 0, 0 }, 64).empty());
+    CHECK(runs({ 0b1, 0 }, 64) == (Runs{ { 0, 1 } }));
+    CHECK(runs({ 0x80000000u, 0b11 }, 64) == (Runs{ { 31, 3 } })); // across a word boundary
+    CHECK(runs({ 0, 0, 0b100 }, 96) == (Runs{ { 66, 1 } }));        // clear words skipped
+    CHECK(runs({ 0b1011 }, 32) == (Runs{ { 0, 2 }, { 3, 1 } }));
+    CHECK(runs({ ~0u, ~0u }, 40) == (Runs{ { 0, 40 } }));            // ends at blocks
+    CHECK(runs({ 0, 0xFFFFFF00u }, 40).empty());                    // only bits past blocks
+}